@@ -41,6 +41,10 @@ int main( int argc, char** argv ) {
         // stop and restart chronometer
         Chrono.toc("construct").tic();
 
+        // generate the windows once; subsequent calls to "analyze" reuse them
+        Stft1D.prepare();
+        Chrono.toc("prepare").tic();
+
         // analyze
         Stft1D.analyze( bat_signal );
         Chrono.toc("analyze").tic();
@@ -67,6 +71,16 @@ int main( int argc, char** argv ) {
         Stft1D.synthesize();
         Chrono.toc("synthesize").tic();
 
+        // the same mask as a multiplier, streaming the channels without storing all coefficients at once
+        Stft1D.multiplier( bat_signal , [&]( sigma::point<1>const& x, sigma::point<1>const& step )->sigma::cmpx {
+            return ( x > .0005 && x < .002 ) && (step < 16 && step > 12);
+        } );
+        Chrono.toc("multiplier (streamed)").tic();
+
+        // analyze again, with each thread transforming its channels block by block, right after the multiplication
+        Stft1D.setFused( true ).analyze( bat_signal );
+        Chrono.toc("analyze (fused)").tic();
+
         // save reconstruction
         // sigma::save2file_bin("bat_rec.bin",Stft1D.getReconstruction() );
         // Chrono.toc("saveRecon");
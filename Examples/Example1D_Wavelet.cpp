@@ -6,6 +6,8 @@
 #include <complex>
 // for to_string-conversion
 #include <sstream>
+// for std::setprecision
+#include <iomanip>
 // the class-templace
 #include "SigmaTransformN.h"
 // specific implementations, like STFT, WaveletTransform, etc.
@@ -69,7 +71,16 @@ int main( int argc, char** argv ) {
 
         // save reconstruction
         // sigma::save2file_bin("bat_rec.bin",Wavelet1D.getReconstruction() );
-        // Chrono.toc("saveRecon");
+        // Chrono.toc("saveRecon").tic();
+
+        // decimated coefficients, each channel on a lattice of the length of its window's support
+        Wavelet1D.setSupportThreshold( 1E-6 ).setDecimation( true ).prepare();
+        Chrono.toc("prepare decimated").tic();
+        Wavelet1D.analyze( bat_signal );
+        Chrono.toc("analyze decimated").tic();
+        std::cout << "Decimated: " << std::setprecision(2) << Wavelet1D.getCoeffs().size() / 1E6 << " million coefficients.\n";
+        Wavelet1D.synthesize();
+        Chrono.toc("synthesize decimated");
     } catch( std::exception &e ) {
         // error?
         std::cerr << "Error: " << e.what() << std::endl;
@@ -8,6 +8,8 @@
 #include <chrono>
 // for std::thread
 #include <thread>
+// for std::future
+#include <future>
 // the class-templace
 #include "SigmaTransformN.h"
 
@@ -48,15 +50,15 @@ int main( int argc, char** argv ) {
         // stop and restart chronometer
         Chrono.toc("Done constructing").tic();
 
-        // analyze async
+        // analyze async: the job is queued, and the call returns immediately
         std::cout<<"\n------------------ starting to analyze asynchronously -----------------\n\n";
-        sig.analyze( bat_signal, [&](sigma::SigmaTransform<1>* obj){
+        std::future<void> analyzed = sig.analyzeAsync( bat_signal, [&](sigma::SigmaTransform<1>* obj){
             Chrono.toc("Done analyzing").tic();
         } );
 
-        // synthesize async
+        // synthesize async: runs after the analysis, since the jobs of a transform run in order
         std::cout<<"\n---------------- starting to synthesize asynchronously ----------------\n\n";
-        sig.synthesize( [&](sigma::SigmaTransform<1>* obj){Chrono.toc("Done synthesizing").tic();} );
+        std::future<void> synthesized = sig.synthesizeAsync( [&](sigma::SigmaTransform<1>* obj){Chrono.toc("Done synthesizing").tic();} );
 
         // do some other stuff
         std::cout << "-- Doing some other stuff" << std::flush;
@@ -65,13 +67,23 @@ int main( int argc, char** argv ) {
             std::cout << "." << std::flush;
         } std::cout << "done --\n";
 
-        // wait for asynchronous jobs to join
-        std::cout<<"\n----------------------- waiting for threads to join -------------------\n\n";
+        // wait for the jobs; "get" rethrows the error of a job, "join" waits for all jobs of the transform
+        std::cout<<"\n------------------------ waiting for the jobs --------------------------\n\n";
+        analyzed.get();
+        synthesized.get();
         sig.join();
 
         // save
-        std::cout << "\nAll joined. Saving to file." << std::endl;
+        std::cout << "\nAll done. Saving to file." << std::endl;
         sigma::save2file_bin("bat_out_async.bin",sig.getReconstruction() );
+
+        // errors of jobs queued with a callback are rethrown by "join", e.g. a mask of the wrong size
+        sig.multiplier( bat_signal, cxVec( 1 ), [](sigma::SigmaTransform<1>* obj){} );
+        try {
+            sig.join();
+        } catch( std::exception &e ) {
+            std::cout << "The asynchronous multiplier failed: " << e.what() << std::endl;
+        }
     } catch( std::exception &e ) {
         // error?
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,68 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+int main( int argc, char** argv ) {
+    try {
+        // Chronometer, for benchmarking purposes
+        sigma::Chronometer Chrono;
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+
+        // setup: many short signals, here circular shifts of the bat signal, one after another
+        double Fs = 143000, len = bat_signal.size(), numsteps = 50;
+        int    numSignals = 1000;
+        cxVec  batch( numSignals * bat_signal.size() );
+        for( int m = 0 ; m < numSignals ; ++m )
+            for( size_t i = 0 ; i < bat_signal.size() ; ++i )
+                batch[m*bat_signal.size() + i] = bat_signal[( i + m ) % bat_signal.size()];
+        std::vector<sigma::point<1>> chans = sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) );
+
+        //construct 1D Wavelet transform, and generate the windows beforehand
+        sigma::WaveletTransform1D Wavelet1D( (sigma::point<1>) 4.0 , Fs , len , chans );
+        Wavelet1D.prepare();
+        std::cout << "Wavelet transform with " << (int)numsteps << " channels, " << numSignals << " signals of length " << (int)len << ".\n\n";
+
+        // one signal after another, collecting the coefficients and the reconstructions
+        cxVec coeffs, single( batch.size() );
+        coeffs.reserve( numSignals * numsteps * len );
+        Chrono.tic();
+        for( int m = 0 ; m < numSignals ; ++m ) {
+            cxVec sig( batch.begin() + m*bat_signal.size() , batch.begin() + (m+1)*bat_signal.size() );
+            cxVec const& c = Wavelet1D.analyze( sig ).getCoeffs();
+            coeffs.insert( coeffs.end() , c.begin() , c.end() );
+            cxVec const& rec = Wavelet1D.synthesize().getReconstruction();
+            std::copy( rec.begin() , rec.end() , single.begin() + m*bat_signal.size() );
+        }
+        Chrono.toc("one signal at a time").tic();
+
+        // all signals at once: the coefficients form a [numSignals][numsteps][len] tensor
+        Wavelet1D.analyzeBatch( batch );
+        Chrono.toc("analyzeBatch").tic();
+        Wavelet1D.synthesizeBatch();
+        Chrono.toc("synthesizeBatch");
+        std::cout << "coefficients of the batch: " << Wavelet1D.getBatchCoeffs().size() << " = "
+                  << Wavelet1D.getBatchSize() << " x " << Wavelet1D.getCoeffOffsets().back() << "\n";
+
+        // both reconstruct the same signals
+        cxVec const& rec = Wavelet1D.getBatchReconstruction();
+        double diff = 0;
+        for( size_t i = 0 ; i < rec.size() ; ++i )
+            diff = std::max( diff , std::abs( rec[i] - single[i] ) );
+        std::cout << "maximal difference of the reconstructions: " << std::scientific << diff << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
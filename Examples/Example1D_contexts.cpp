@@ -0,0 +1,67 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for std::thread
+#include <thread>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+int main( int argc, char** argv ) {
+    try {
+        // Chronometer, for benchmarking purposes
+        sigma::Chronometer Chrono;
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+
+        // setup: many channels, and a few threads serving requests
+        double Fs = 143000, len = bat_signal.size(), numsteps = 2000;
+        int    numThreads = 4, reps = 25;
+        std::vector<sigma::point<1>> chans = sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) );
+
+        // the plan: generate the windows once
+        sigma::WaveletTransform1D Plan( (sigma::point<1>) 4.0 , Fs , len , chans );
+        Chrono.tic();
+        Plan.prepare();
+        Chrono.toc("prepare the plan");
+        cxVec const& want = Plan.analyze( bat_signal ).synthesize().getReconstruction();
+
+        // a context per thread: copies share the window bank, but have buffers of their own. They would share the
+        // thread pool of the plan, too, on which only one of them at a time runs parallel loops; with a single thread,
+        // each context runs its loops in its own thread instead
+        std::vector<sigma::WaveletTransform1D> contexts( numThreads , Plan );
+        for( auto& ctx : contexts )
+            ctx.setNumThreads( 1 );
+        std::cout << "window bank: " << Plan.getWindowBank().bytes() / 1024 << " KiB, held once, shared by "
+                  << numThreads << " contexts: " << ( &contexts[0].getWindowBank() == &Plan.getWindowBank() ? "yes" : "no" ) << "\n";
+
+        // serve the requests concurrently
+        std::vector<double>      diff( numThreads , 0 );
+        std::vector<std::thread> threads;
+        Chrono.tic();
+        for( int t = 0 ; t < numThreads ; ++t ) {
+            threads.emplace_back( [&,t]() {
+                for( int r = 0 ; r < reps ; ++r ) {
+                    cxVec const& rec = contexts[t].analyze( bat_signal ).synthesize().getReconstruction();
+                    for( size_t i = 0 ; i < rec.size() ; ++i )
+                        diff[t] = std::max( diff[t] , std::abs( rec[i] - want[i] ) );
+                }
+            } );
+        }
+        for( auto& th : threads )
+            th.join();
+        Chrono.toc("analyze + synthesize in each context");
+        std::cout << "maximal difference to the plan: " << std::scientific << *std::max_element( diff.begin() , diff.end() ) << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
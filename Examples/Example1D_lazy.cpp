@@ -0,0 +1,73 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for to_string-conversion
+#include <sstream>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+// runs "reps" analyses and syntheses of "sig", reporting the timings and the memory of the window bank
+cxVec benchmark( sigma::SigmaTransform1D& T , cxVec const& sig , int const& reps ) {
+    sigma::Chronometer Chrono;
+    Chrono.tic();
+    T.prepare();
+    Chrono.toc("prepare").tic();
+    for( int r = 0 ; r < reps ; ++r )
+        T.analyze( sig );
+    Chrono.toc("analyze").tic();
+    for( int r = 0 ; r < reps ; ++r )
+        T.synthesize();
+    Chrono.toc("synthesize");
+    std::cout << "window bank: " << T.getWindowBank().bytes() / 1024 << " KiB, coefficients: "
+              << T.getCoeffs().size() * sizeof(std::complex<double>) / 1024 << " KiB\n";
+    return T.getReconstruction();
+}
+
+int main( int argc, char** argv ) {
+    try {
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+
+        // setup: many channels, such that the window bank is large
+        double Fs = 143000, len = bat_signal.size(), numsteps = 2000;
+        int    reps = 20;
+        std::vector<sigma::point<1>> chans = sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) );
+
+        //construct 1D Wavelet transform, with the logarithm of the modulus as diffeomorphism
+        sigma::SigmaTransform1D Wavelet1D(
+            sigma::logabs<1>,              // spectral diffeomorphism
+            (sigma::point<1>)4.0,          // window or: width (in steps) of a warped Gaussian window
+            Fs ,                           // spatial/temporal sampling rate  ( point<N> )
+            len ,                          // signal length ( point<N> )
+            chans                          // shift-steps in warped Fourier domain ( point<N>-vec )
+        );
+        std::cout << "Wavelet transform with " << (int)numsteps << " channels, " << reps << " repetitions each.\n";
+
+        // the windows are stored in the bank
+        std::cout<<"\n---------------------------- stored windows ---------------------------\n\n";
+        cxVec stored = benchmark( Wavelet1D , bat_signal , reps );
+
+        // the windows are evaluated on the fly, per channel
+        std::cout<<"\n------------------------- windows on the fly --------------------------\n\n";
+        Wavelet1D.setLazyWindows( true );
+        cxVec lazy = benchmark( Wavelet1D , bat_signal , reps );
+
+        // both reconstruct the same signal, up to the order of the summation
+        double diff = 0;
+        for( size_t i = 0 ; i < stored.size() ; ++i )
+            diff = std::max( diff , std::abs( stored[i] - lazy[i] ) );
+        std::cout << "\nmaximal difference of the reconstructions: " << std::scientific << diff << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
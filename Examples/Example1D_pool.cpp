@@ -0,0 +1,80 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for to_string-conversion
+#include <sstream>
+// for std::thread
+#include <thread>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+int main( int argc, char** argv ) {
+    try {
+        // Chronometer, for benchmarking purposes
+        sigma::Chronometer    Chrono;
+
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+
+        // setup: a short signal, few channels and many repetitions, such that the thread overhead matters
+        double Fs = 143000, len = bat_signal.size(), numsteps = 64;
+        int    numThreads = 4, reps = 500;
+
+        //construct 1D Wavelet transform
+        sigma::WaveletTransform1D    sigT1D(
+            (sigma::point<1>)4.0,          // window or: width (in steps) of a warped Gaussian window
+            Fs ,                           // spatial/temporal sampling rate  ( point<N> )
+            len ,                          // signal length ( point<N> )
+            sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) )
+        );
+        sigT1D.setNumThreads( numThreads ).prepare();
+        std::cout << "Wavelet transform with " << (int)numsteps << " channels, " << reps << " repetitions each.\n";
+
+        // the bare overhead of a parallel loop
+        std::cout<<"\n------------------------- empty parallel loops ------------------------\n\n";
+        std::vector<int> counter( numThreads );
+        Chrono.tic();
+        for( int r = 0 ; r < reps ; ++r ) {
+            std::vector<std::thread> threads;
+            for( int k = 0 ; k < numThreads ; ++k )
+                threads.emplace_back( [&counter,k](){ ++counter[k]; } );
+            for( auto& t : threads )
+                t.join();
+        }
+        Chrono.toc("spawn and join threads").tic();
+        sigma::ThreadPool pool( numThreads );
+        for( int r = 0 ; r < reps ; ++r )
+            pool.parallelFor( numThreads , [&counter]( int const& k ){ ++counter[k]; } );
+        Chrono.toc("thread pool").tic();
+
+        // the transform itself
+        std::cout<<"\n------------------------- analyze + synthesize ------------------------\n\n";
+        sigT1D.setThreadPool( NULL ).setNumThreads( numThreads );
+        Chrono.tic();
+        for( int r = 0 ; r < reps ; ++r )
+            sigT1D.analyze( bat_signal ).synthesize();
+        Chrono.toc("spawn and join threads").tic();
+
+        sigT1D.setThreadPool( sigma::ThreadPool::shared( numThreads ) );
+        for( int r = 0 ; r < reps ; ++r )
+            sigT1D.analyze( bat_signal ).synthesize();
+        Chrono.toc("shared thread pool").tic();
+
+        sigT1D.setThreadPool( std::make_shared<sigma::ThreadPool>( numThreads , true ) );
+        for( int r = 0 ; r < reps ; ++r )
+            sigT1D.analyze( bat_signal ).synthesize();
+        Chrono.toc("pinned thread pool").tic();
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for the timing
+#include <chrono>
+// for std::setw
+#include <iomanip>
+// the complex kernels
+#include "SigmaTransform_simd.h"
+
+namespace sigma  = SigmaTransform;
+
+// runs "kernel" "reps" times and returns the GFLOP/s, given the number of floating point operations per call
+template<class F>
+double gflops( F const& kernel , int const& reps , double const& flops ) {
+    auto tic = std::chrono::steady_clock::now();
+    for( int r = 0 ; r < reps ; ++r )
+        kernel();
+    double sec = std::chrono::duration<double>( std::chrono::steady_clock::now() - tic ).count();
+    return flops * reps / sec * 1E-9;
+}
+
+// benchmarks the kernels of each supported instruction set in precision "T"
+template<class T>
+void benchmark( size_t const& len , int const& reps ) {
+    using cmpx = std::complex<T>;
+    std::vector<cmpx> w( len , cmpx( 0.5 , -0.25 ) ), x( len , cmpx( 1 , 2 ) ), out( len ) , acc( len );
+    std::vector<T>    rw( len , 0.5 );
+    for( int l = 0 ; l <= (int) sigma::detectSimdLevel() ; ++l ) {
+        sigma::ComplexKernels<T> const& K = sigma::ComplexKernels<T>::get( (sigma::SimdLevel) l );
+        // conj( w ) * x * s: 6 flops for the product, 2 for the scaling
+        double g1 = gflops( [&](){ K.conjMulScale( out.data() , w.data() , x.data() , (T) 1E-3 , len ); } , reps , 8.0 * len );
+        // x *= w: 6 flops
+        double g2 = gflops( [&](){ K.mul( out.data() , w.data() , len ); } , reps , 6.0 * len );
+        // acc += x * w * s: 6 flops for the product, 2 for the scaling, 2 for the sum
+        double g3 = gflops( [&](){ K.mulAcc( acc.data() , x.data() , w.data() , (T) 1E-3 , len ); } , reps , 10.0 * len );
+        // real w * x * s: 2 flops for the product, 2 for the scaling
+        double g4 = gflops( [&](){ K.realMulScale( out.data() , rw.data() , x.data() , (T) 1E-3 , len ); } , reps , 4.0 * len );
+        // acc += x * real w * s: 2 flops for the product, 2 for the scaling, 2 for the sum
+        double g5 = gflops( [&](){ K.realMulAcc( acc.data() , x.data() , rw.data() , (T) 1E-3 , len ); } , reps , 6.0 * len );
+        std::cout << std::setw(10) << sigma::simdLevelName( (sigma::SimdLevel) l ) << std::fixed << std::setprecision(2)
+                  << std::setw(16) << g1 << std::setw(16) << g2 << std::setw(16) << g3 << std::setw(16) << g4 << std::setw(16) << g5 << "\n";
+    }
+}
+
+int main( int argc, char** argv ) {
+    try {
+        // in the cache: the length of a typical support of a window
+        size_t len = 4096;
+        int    reps = 20000;
+
+        std::cout << "Best instruction set: " << sigma::simdLevelName( sigma::detectSimdLevel() )
+                  << ", selected: " << sigma::simdLevelName( sigma::ComplexKernels<double>::get().level ) << "\n";
+
+        std::cout<<"\n---------------------------------------- GFLOP/s, double precision --------------------------------------\n\n";
+        std::cout << std::setw(10) << "" << std::setw(16) << "conjMulScale" << std::setw(16) << "mul" << std::setw(16) << "mulAcc"
+                  << std::setw(16) << "realMulScale" << std::setw(16) << "realMulAcc" << "\n";
+        benchmark<double>( len , reps );
+
+        std::cout<<"\n---------------------------------------- GFLOP/s, single precision --------------------------------------\n\n";
+        std::cout << std::setw(10) << "" << std::setw(16) << "conjMulScale" << std::setw(16) << "mul" << std::setw(16) << "mulAcc"
+                  << std::setw(16) << "realMulScale" << std::setw(16) << "realMulAcc" << "\n";
+        benchmark<float>( len , reps );
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for to_string-conversion
+#include <sstream>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+// the statically dispatched variant
+#include "SigmaTransformT.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+int main( int argc, char** argv ) {
+    try {
+        // Chronometer, for benchmarking purposes
+        sigma::Chronometer    Chrono;
+
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+
+        // setup: many channels, such that the windows and the mask dominate
+        double Fs = 143000, len = bat_signal.size(), numsteps = len * 50;
+        std::vector<sigma::point<1>> chans = sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) );
+        sigma::point<1> width( 0.05 );
+
+        // the masking function, as a lambda
+        auto mask = []( sigma::point<1>const& x, sigma::point<1>const& step )->sigma::cmpx {
+            return ( x > .0005 && x < .002 ) && (step < 16 && step > 12);
+        };
+
+        std::cout << "Wavelet transform with " << (int)numsteps << " channels.\n";
+
+        // type-erased: every sample calls std::function-handles
+        std::cout<<"\n---------------------------- std::function ----------------------------\n\n";
+        sigma::WaveletTransform1D Wavelet1D(
+            [width]( sigma::point<1> const& x ){ return sigma::gauss_stddev( x , width ); } ,
+            Fs , len , chans
+        );
+        Chrono.tic();
+        Wavelet1D.prepare();
+        Chrono.toc("prepare").tic();
+        Wavelet1D.analyze( bat_signal );
+        Chrono.toc("analyze").tic();
+        Wavelet1D.applyMask( mask );
+        Chrono.toc("mask").tic();
+
+        // statically dispatched: the diffeomorphism, window, action and mask are inlined
+        std::cout<<"\n------------------------- template functors ---------------------------\n\n";
+        sigma::SigmaTransformT<1,sigma::functors::LogPos<1>,sigma::functors::GaussStddev<1>> WaveletT1D(
+            sigma::functors::LogPos<1>() ,
+            sigma::functors::GaussStddev<1>( width ) ,
+            Fs , len , chans
+        );
+        Chrono.tic();
+        WaveletT1D.prepare();
+        Chrono.toc("prepare").tic();
+        WaveletT1D.analyze( bat_signal );
+        Chrono.toc("analyze").tic();
+        WaveletT1D.applyMask( mask );
+        Chrono.toc("mask").tic();
+
+        // both compute the same coefficients
+        double diff = 0;
+        for( size_t i = 0 ; i < Wavelet1D.getCoeffs().size() ; ++i )
+            diff = std::max( diff , std::abs( Wavelet1D.getCoeffs()[i] - WaveletT1D.getCoeffs()[i] ) );
+        std::cout << "\nmaximal difference of the coefficients: " << diff << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -74,6 +74,12 @@ int main( int argc, char** argv ) {
             Chrono.toc(ss.str()).tic();
         }
 
+        // the parallel synthesis is reproducible for a fixed number of threads
+        cxVec rec = sigT1D.getReconstruction();
+        std::cout << "repeated synthesis is "
+                  << ( rec == sigT1D.synthesize().getReconstruction() ? "bit-identical" : "NOT bit-identical" ) << "\n";
+        Chrono.tic();
+
         // save reconstruction
         sigma::save2file_bin("bat_rec.bin",sigT1D.getReconstruction() );
         Chrono.toc("saveRecon");
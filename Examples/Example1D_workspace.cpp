@@ -0,0 +1,80 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// for counting the allocations
+#include <atomic>
+#include <new>
+#include <cstdlib>
+// the class-templace
+#include "SigmaTransformN.h"
+// specific implementations, like STFT, WaveletTransform, etc.
+#include "SigmaTransform1D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+// counts every allocation on the heap by the global operator new
+static std::atomic<long> numAllocations( 0 );
+
+// GCC takes the replaced operators below for a mismatch of new and free
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new( std::size_t size ) {
+    ++numAllocations;
+    if( void* p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+void  operator delete( void* p ) noexcept                { std::free( p ); }
+void  operator delete( void* p , std::size_t ) noexcept  { std::free( p ); }
+
+// runs "job" once to warm up, then "reps" times, and returns the number of allocations per repetition
+template<class F>
+double allocationsPerCall( F const& job , int const& reps ) {
+    job();
+    long before = numAllocations;
+    for( int r = 0 ; r < reps ; ++r )
+        job();
+    return (double) ( numAllocations - before ) / reps;
+}
+
+int main( int argc, char** argv ) {
+    try {
+        // load bat signal
+        cxVec bat_signal = sigma::loadAscii1D( "Signals/bat.asc" );
+        std::vector<double> bat_real( bat_signal.size() );
+        for( size_t i = 0 ; i < bat_signal.size() ; ++i )
+            bat_real[i] = bat_signal[i].real();
+
+        // setup
+        double Fs = 143000, len = bat_signal.size(), numsteps = 200;
+        int    reps = 100;
+        std::vector<sigma::point<1>> chans = sigma::meshgridN<1>( sigma::linspace( log2(Fs*0.005) , log2(Fs/2*1.1) , numsteps ) );
+        auto mask = []( sigma::point<1> const& x , sigma::point<1> const& step ) -> sigma::cmpx { return x[0] < 0.001; };
+
+        //construct 1D Wavelet transform, with a workspace shared with a second transform, which is not used concurrently
+        sigma::WaveletTransform1D Wavelet1D( (sigma::point<1>) 4.0 , Fs , len , chans );
+        std::shared_ptr<sigma::Workspace<1>> workspace = Wavelet1D.getWorkspace();
+        sigma::STFT1D STFT( (sigma::point<1>) 4.0 , Fs , len , sigma::meshgridN<1>( sigma::linspace( -Fs/2 , Fs/2 , numsteps ) ) );
+        STFT.setWorkspace( workspace );
+
+        // after the first call, the buffers of the workspace, the coefficients and the reconstruction are reused
+        std::cout << "heap allocations per call, after the first one:\n\n";
+        std::cout << "analyze + synthesize:            " << allocationsPerCall( [&](){ Wavelet1D.analyze( bat_signal ).synthesize(); } , reps ) << "\n";
+        std::cout << "analyze + synthesizeReal (real): " << allocationsPerCall( [&](){ Wavelet1D.analyze( bat_real ).synthesizeReal(); } , reps ) << "\n";
+        std::cout << "analyze + applyMask + synthesize:" << allocationsPerCall( [&](){ Wavelet1D.analyze( bat_signal ).applyMask( mask ).synthesize(); } , reps ) << "\n";
+        std::cout << "multiplier:                      " << allocationsPerCall( [&](){ Wavelet1D.multiplier( bat_signal , mask ); } , reps ) << "\n";
+        Wavelet1D.setLazyWindows( true );
+        std::cout << "lazy analyze + synthesize:       " << allocationsPerCall( [&](){ Wavelet1D.analyze( bat_signal ).synthesize(); } , reps ) << "\n";
+        std::cout << "STFT, shared workspace:          " << allocationsPerCall( [&](){ STFT.analyze( bat_signal ).synthesize(); } , reps ) << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -50,6 +50,11 @@ int main( int argc , char** argv ) {
         // stop and restart chronometer
         Chrono.toc("construct").tic();
 
+        // load the FFTW wisdom of a previous run, if any, and measure the FFT plans
+        sigma::FFTPlanCache::instance().importWisdom( "curvelet.wisdom" );
+        CurveT.setPlannerRigor( FFTW_MEASURE ).prepare();
+        Chrono.toc("prepare").tic();
+
         // analyze
         CurveT( lena ); // == CurveT.analyze( lena );
         Chrono.toc("analyze").tic();
@@ -58,6 +63,19 @@ int main( int argc , char** argv ) {
         CurveT.synthesize();
         Chrono.toc("synthesize").tic();
 
+        // analyze again, now using the cached plans
+        CurveT( lena );
+        Chrono.toc("analyze (cached plans)").tic();
+
+        // analyze with each thread transforming its channels block by block, right after the multiplication
+        CurveT.setFused( true )( lena );
+        Chrono.toc("analyze (fused, measure plans)").tic();
+        CurveT( lena );
+        Chrono.toc("analyze (fused)").tic();
+
+        // save the wisdom for the next run
+        sigma::FFTPlanCache::instance().exportWisdom( "curvelet.wisdom" );
+
         // save coefficients
         // sigma::save2file_bin( "lena_coeff.bin", CurveT.getCoeffs() );
         // Chrono.toc("saveCoeffs").tic();
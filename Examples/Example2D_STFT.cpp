@@ -55,6 +55,16 @@ int main( int argc , char** argv ) {
         sigT2D.synthesize();
         Chrono.toc("synthesize").tic();
 
+        // the image is real: analyze with a real-to-complex FFT and synthesize the real part only
+        std::vector<double> lenaReal( lena.size() );
+        for( size_t i = 0 ; i < lena.size() ; ++i )
+            lenaReal[i] = lena[i].real();
+        Chrono.toc("convert to real").tic();
+        sigT2D.analyze( lenaReal );
+        Chrono.toc("analyze real").tic();
+        sigT2D.synthesizeReal();
+        Chrono.toc("synthesize real").tic();
+
         // save coefficients
         // sigma::save2file_bin( "bat_coeff.bin", sigT2D.getCoeffs() );
         // Chrono.toc("saveCoeffs").tic();
@@ -0,0 +1,66 @@
+// for std::cerr,std::cout
+#include <iostream>
+// for std::vector
+#include <vector>
+// for std::complex
+#include <complex>
+// the class-template
+#include "SigmaTransformN.h"
+// specific implementations, like STFT2D, SIM2Transform, ShearletTransform, etc.
+#include "SigmaTransform2D.h"
+
+namespace sigma  = SigmaTransform;
+using cxVec = std::vector<std::complex<double>>;
+
+// window in the warped (polar) Fourier domain: a rectangle in (0,2] x [0,pi/32)
+sigma::cmpx rect2D( sigma::point<2> const& p ) {
+    return (0<p[0] && p[0]<=2) && (0<=p[1] && p[1]<(M_PI/32));
+}
+
+int main( int argc , char** argv ) {
+    try {
+        // Chronometer, for benchmarking purposes
+        sigma::Chronometer    Chrono;
+        // load lena
+        int x, y;
+        cxVec lena = sigma::loadAscii2D( "Signals/lena.asc", x, y );
+        sigma::point<2> sz( std::array<double,2>{ (double)x , (double)y } ), Fs( sz );
+
+        // make channels, with the step-width adjusted to parabolic scaling
+        std::vector<sigma::point<2>> grid = sigma::meshgridN<2>(
+                        std::array<std::vector<double>,2>{ sigma::linspace( log2(1), log2(64), 4 ) ,
+                                                           sigma::linspace( -M_PI/2, M_PI/2,  33 ) });
+        for( auto& st : grid )
+            st[1] *= exp( log(2)/2 * st[0] );
+
+        // generate the windows, as usual
+        sigma::Curvelet2D Generated( rect2D , Fs , sz , grid );
+        Chrono.tic();
+        Generated.prepare();
+        Chrono.toc("generate the windows").tic();
+
+        // with a cache file: the windows are generated and written on the first run, and mapped on later runs
+        sigma::Curvelet2D First( rect2D , Fs , sz , grid );
+        First.setWindowCache( "curvelet.bank" ).prepare();
+        Chrono.toc( First.getWindowBank().isMapped() ? "map the windows" : "generate and write the windows" ).tic();
+
+        // now, the file is there and matches: the bank is mapped, without generating or copying the windows
+        sigma::Curvelet2D Second( rect2D , Fs , sz , grid );
+        Second.setWindowCache( "curvelet.bank" ).prepare();
+        Chrono.toc("map the windows");
+        std::cout << "window bank: " << Second.getWindowBank().bytes() / 1024 << " KiB, mapped: "
+                  << ( Second.getWindowBank().isMapped() ? "yes" : "no" ) << "\n";
+
+        // both give the same coefficients
+        cxVec const& c1 = Generated( lena ).getCoeffs();
+        cxVec const& c2 = Second( lena ).getCoeffs();
+        double diff = 0;
+        for( size_t i = 0 ; i < c1.size() ; ++i )
+            diff = std::max( diff , std::abs( c1[i] - c2[i] ) );
+        std::cout << "maximal difference of the coefficients: " << diff << "\n";
+    } catch( std::exception &e ) {
+        // error?
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return 0;
+}
@@ -5,36 +5,59 @@
 
 namespace SigmaTransform {
 
-    SigmaTransform1D::SigmaTransform1D(
+    template<class T>
+    BasicSigmaTransform1D<T>::BasicSigmaTransform1D(
         diffFunc<1> sigma, winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps, actFunc<1> act )
-        : SigmaTransform<1>( sigma, window, Fs , size , steps , act ) { }
+        : SigmaTransform<1,T>( sigma, window, Fs , size , steps , act ) { }
 
-    SigmaTransform1D::SigmaTransform1D(
+    template<class T>
+    BasicSigmaTransform1D<T>::BasicSigmaTransform1D(
         diffFunc<1> sigma, const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps, actFunc<1> act )
-        : SigmaTransform<1>( sigma, width, Fs , size , steps , act ) { }
+        : SigmaTransform<1,T>( sigma, width, Fs , size , steps , act ) { }
 
 
-    STFT1D::STFT1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( id<1>, window, Fs , size , steps ) { }
+    template<class T>
+    BasicSTFT1D<T>::BasicSTFT1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( id<1>, window, Fs , size , steps ) { }
 
-    STFT1D::STFT1D( const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( id<1>, width, Fs , size , steps ) { }
+    template<class T>
+    BasicSTFT1D<T>::BasicSTFT1D( const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( id<1>, width, Fs , size , steps ) { }
 
 
-    WaveletTransform1D::WaveletTransform1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( logpos<1>, window, Fs , size , steps ) { }
+    template<class T>
+    BasicWaveletTransform1D<T>::BasicWaveletTransform1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( logpos<1>, window, Fs , size , steps ) { }
 
-    WaveletTransform1D::WaveletTransform1D(const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( logpos<1>, width, Fs , size , steps ) { }
+    template<class T>
+    BasicWaveletTransform1D<T>::BasicWaveletTransform1D(const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( logpos<1>, width, Fs , size , steps ) { }
 
 
-    CQTransform1D::CQTransform1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( cq, window, Fs , size , steps ) { }
+    template<class T>
+    BasicCQTransform1D<T>::BasicCQTransform1D( winFunc<1> window, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( cq, window, Fs , size , steps ) {
+        this->setSigma( cq , functors::ConstantQ( Q , f_0 ) );
+    }
 
-    CQTransform1D::CQTransform1D( const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
-        : SigmaTransform<1>( cq, width, Fs , size , steps ) { }
+    template<class T>
+    BasicCQTransform1D<T>::BasicCQTransform1D( const point<1> &width, const point<1> &Fs, const point<1> &size, const std::vector<point<1>> &steps )
+        : SigmaTransform<1,T>( cq, width, Fs , size , steps ) {
+        this->setSigma( cq , functors::ConstantQ( Q , f_0 ) );
+    }
 
 
-    double CQTransform1D::cq( const point<1> &x ) { return Q * log2( abs( x[0] / f_0 ) + 1E-16 ); };
+    template<class T>
+    double BasicCQTransform1D<T>::cq( const point<1> &x ) { return functors::ConstantQ( Q , f_0 )( x )[0]; };
+
+    // precompiled instantiations
+    template class BasicSigmaTransform1D<double>;
+    template class BasicSigmaTransform1D<float>;
+    template class BasicSTFT1D<double>;
+    template class BasicSTFT1D<float>;
+    template class BasicWaveletTransform1D<double>;
+    template class BasicWaveletTransform1D<float>;
+    template class BasicCQTransform1D<double>;
+    template class BasicCQTransform1D<float>;
 
 } // namespace SigmaTransform
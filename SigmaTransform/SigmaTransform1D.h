@@ -8,13 +8,14 @@
 namespace SigmaTransform {
 
     /** Class SigmaTransform1D is a one-dimensional instantation of SigmaTransform<N>
-    *   and can thus, since no more templates are involved, be used in a precompiled form.
+    *   and is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class SigmaTransform1D : public SigmaTransform<1> {
+    template<class T = double>
+    class BasicSigmaTransform1D : public SigmaTransform<1,T> {
         public:
-        SigmaTransform1D(
+        BasicSigmaTransform1D(
             diffFunc<1> sigma = NULL,
             winFunc<1> window = NULL,
             const point<1> &Fs = point<1>(0),
@@ -22,7 +23,7 @@ namespace SigmaTransform {
             const std::vector<point<1>> &steps = std::vector<point<1>>(0),
             actFunc<1> act = minus<1>
         );
-        SigmaTransform1D(
+        BasicSigmaTransform1D(
             diffFunc<1> sigma = NULL,
             const point<1> &width = 0,
             const point<1> &Fs = point<1>(0),
@@ -32,21 +33,26 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicSigmaTransform1D<double>  SigmaTransform1D;
+    typedef BasicSigmaTransform1D<float>   SigmaTransform1Df;
+
     /** Class STFT1D is a one-dimensional STFT-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the identity.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class STFT1D : public SigmaTransform<1> {
+    template<class T = double>
+    class BasicSTFT1D : public SigmaTransform<1,T> {
         public:
-        STFT1D(
+        BasicSTFT1D(
             winFunc<1> window = NULL,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
             const std::vector<point<1>> &steps = std::vector<point<1>>(0)
         );
-        STFT1D(
+        BasicSTFT1D(
             const point<1> &width,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
@@ -54,21 +60,26 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicSTFT1D<double>  STFT1D;
+    typedef BasicSTFT1D<float>   STFT1Df;
+
     /** Class WaveletTransform1D is a one-dimensional Wavelet-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the (binary) logarithm.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class WaveletTransform1D : public SigmaTransform<1> {
+    template<class T = double>
+    class BasicWaveletTransform1D : public SigmaTransform<1,T> {
         public:
-        WaveletTransform1D(
+        BasicWaveletTransform1D(
             winFunc<1> window = NULL,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
             const std::vector<point<1>> &steps = std::vector<point<1>>(0)
         );
-        WaveletTransform1D(
+        BasicWaveletTransform1D(
             const point<1> &width,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
@@ -76,24 +87,29 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicWaveletTransform1D<double>  WaveletTransform1D;
+    typedef BasicWaveletTransform1D<float>   WaveletTransform1Df;
+
     /** Class CQTransform1D is a one-dimensional ConstantQ-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to Q * log2(x/f_0).
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class CQTransform1D : public SigmaTransform<1> {
+    template<class T = double>
+    class BasicCQTransform1D : public SigmaTransform<1,T> {
         static const int Q = 8, f_0 = 1;
         static double cq( const point<1> &x );
 
         public:
-        CQTransform1D(
+        BasicCQTransform1D(
             winFunc<1> window = NULL,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
             const std::vector<point<1>> &steps = std::vector<point<1>>(0)
         );
-        CQTransform1D(
+        BasicCQTransform1D(
             const point<1> &width,
             const point<1> &Fs = point<1>(0),
             const point<1> &size = point<1>(0),
@@ -101,6 +117,10 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicCQTransform1D<double>  CQTransform1D;
+    typedef BasicCQTransform1D<float>   CQTransform1Df;
+
 } // namespace SigmaTransform
 
 #endif //SIGMATRANSFORM1D_H
@@ -5,67 +5,113 @@
 
 namespace SigmaTransform {
 
-    point<2> polar(const point<2> &p) {
-        //return std::move( point<2>({ log2( p.sq().sum()+1E-16 )/2.0, atan2( p[1] , p[0] ) }) );
-        return std::move( point<2>(std::array<double,2>{ log2( p.sq().sum()+1E-16 )/2.0, atan( p[1] / p[0] ) }) );
-    }
+    // the formulas are found in SigmaTransform_functors.h
+    point<2> polar(const point<2> &p) { return functors::Polar()( p ); }
 
-    point<2> shear(const point<2> &p) {
-        return std::move( point<2>(std::array<double,2>{ log2( abs(p[0]) + 1E-16 ), p[1] / p[0] }) );
-    }
+    point<2> shear(const point<2> &p) { return functors::Shear()( p ); }
 
-    point<2> parabolicAction(const point<2> &l ,const point<2> &r ) {
-        return std::move( point<2>(std::array<double,2>{ l[0] - r[0] , exp( -r[0] / 2.0 * log(2) )  * ( l[1] - r[1] ) }) );
-    }
+    point<2> parabolicAction(const point<2> &l ,const point<2> &r ) { return functors::ParabolicAction()( l , r ); }
+
+    void batch::polar( pointArray<2> &x ) { functors::Polar()( x ); }
 
-    SigmaTransform2D::SigmaTransform2D(
+    void batch::shear( pointArray<2> &x ) { functors::Shear()( x ); }
+
+    void batch::parabolicAction( pointArray<2> &l , const point<2> &r ) { functors::ParabolicAction()( l , r ); }
+
+    template<class T>
+    BasicSigmaTransform2D<T>::BasicSigmaTransform2D(
         diffFunc<2> sigma, winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps, actFunc<2> act )
-        : SigmaTransform<2>( sigma, window, Fs , size , steps , act ) { }
+        : SigmaTransform<2,T>( sigma, window, Fs , size , steps , act ) { }
 
-    SigmaTransform2D::SigmaTransform2D(
+    template<class T>
+    BasicSigmaTransform2D<T>::BasicSigmaTransform2D(
         diffFunc<2> sigma, const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps, actFunc<2> act )
-        : SigmaTransform<2>( sigma, width, Fs , size , steps , act ) { }
+        : SigmaTransform<2,T>( sigma, width, Fs , size , steps , act ) { }
 
 
-    STFT2D::STFT2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( id<2>, window, Fs , size , steps ) { }
+    template<class T>
+    BasicSTFT2D<T>::BasicSTFT2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( id<2>, window, Fs , size , steps ) { }
 
-    STFT2D::STFT2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( id<2>, width, Fs , size , steps ) { }
+    template<class T>
+    BasicSTFT2D<T>::BasicSTFT2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( id<2>, width, Fs , size , steps ) { }
 
 
-    WaveletTransform2D::WaveletTransform2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( logabs<2>, window, Fs , size , steps ) { }
+    template<class T>
+    BasicWaveletTransform2D<T>::BasicWaveletTransform2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( logabs<2>, window, Fs , size , steps ) { }
 
-    WaveletTransform2D::WaveletTransform2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( logabs<2>, width, Fs , size , steps ) { }
+    template<class T>
+    BasicWaveletTransform2D<T>::BasicWaveletTransform2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( logabs<2>, width, Fs , size , steps ) { }
 
 
-    SIM2D::SIM2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( polar, window, Fs , size , steps ) { }
+    template<class T>
+    BasicSIM2D<T>::BasicSIM2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( polar, window, Fs , size , steps ) {
+        this->setSigma( polar , batch::polar );
+    }
 
-    SIM2D::SIM2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( polar, width, Fs , size , steps ) { }
+    template<class T>
+    BasicSIM2D<T>::BasicSIM2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( polar, width, Fs , size , steps ) {
+        this->setSigma( polar , batch::polar );
+    }
 
 
-    Curvelet2D::Curvelet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( polar, window, Fs , size , steps , parabolicAction ) { }
+    template<class T>
+    BasicCurvelet2D<T>::BasicCurvelet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( polar, window, Fs , size , steps , parabolicAction ) {
+        this->setSigma( polar , batch::polar ).setAction( parabolicAction , batch::parabolicAction );
+    }
 
-    Curvelet2D::Curvelet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( polar, width, Fs , size , steps , parabolicAction ) { }
+    template<class T>
+    BasicCurvelet2D<T>::BasicCurvelet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( polar, width, Fs , size , steps , parabolicAction ) {
+        this->setSigma( polar , batch::polar ).setAction( parabolicAction , batch::parabolicAction );
+    }
 
 
-    NPShearlet2D::NPShearlet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( shear, window, Fs , size , steps ) { }
+    template<class T>
+    BasicNPShearlet2D<T>::BasicNPShearlet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( shear, window, Fs , size , steps ) {
+        this->setSigma( shear , batch::shear );
+    }
 
-    NPShearlet2D::NPShearlet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( shear, width, Fs , size , steps ) { }
+    template<class T>
+    BasicNPShearlet2D<T>::BasicNPShearlet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( shear, width, Fs , size , steps ) {
+        this->setSigma( shear , batch::shear );
+    }
 
 
-    Shearlet2D::Shearlet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( shear, window, Fs , size , steps , parabolicAction ) { }
+    template<class T>
+    BasicShearlet2D<T>::BasicShearlet2D( winFunc<2> window, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( shear, window, Fs , size , steps , parabolicAction ) {
+        this->setSigma( shear , batch::shear ).setAction( parabolicAction , batch::parabolicAction );
+    }
+
+    template<class T>
+    BasicShearlet2D<T>::BasicShearlet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
+        : SigmaTransform<2,T>( shear, width, Fs , size , steps , parabolicAction ) {
+        this->setSigma( shear , batch::shear ).setAction( parabolicAction , batch::parabolicAction );
+    }
 
-    Shearlet2D::Shearlet2D( const point<2> &width, const point<2> &Fs, const point<2> &size, const std::vector<point<2>> &steps )
-        : SigmaTransform<2>( shear, width, Fs , size , steps , parabolicAction ) { }
+    // precompiled instantiations
+    template class BasicSigmaTransform2D<double>;
+    template class BasicSigmaTransform2D<float>;
+    template class BasicSTFT2D<double>;
+    template class BasicSTFT2D<float>;
+    template class BasicWaveletTransform2D<double>;
+    template class BasicWaveletTransform2D<float>;
+    template class BasicSIM2D<double>;
+    template class BasicSIM2D<float>;
+    template class BasicCurvelet2D<double>;
+    template class BasicCurvelet2D<float>;
+    template class BasicNPShearlet2D<double>;
+    template class BasicNPShearlet2D<float>;
+    template class BasicShearlet2D<double>;
+    template class BasicShearlet2D<float>;
 
 } // namespace SigmaTransform
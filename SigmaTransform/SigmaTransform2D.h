@@ -28,14 +28,22 @@ namespace SigmaTransform {
     */
     point<2> parabolicAction(const point<2> &l ,const point<2> &r);
 
+    // batch forms of the above, operating on many points in place, see SigmaTransform_util.h
+    namespace batch {
+        void polar( pointArray<2> &x );
+        void shear( pointArray<2> &x );
+        void parabolicAction( pointArray<2> &l , const point<2> &r );
+    }
+
     /** Class SigmaTransform2D is a two-dimensional instantation of SigmaTransform<N>
-    *   and can thus, since no more templates are involved, be used in a precompiled form.
+    *   and is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class SigmaTransform2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicSigmaTransform2D : public SigmaTransform<2,T> {
         public:
-        SigmaTransform2D(
+        BasicSigmaTransform2D(
             diffFunc<2> sigma = NULL,
             winFunc<2> window = NULL,
             const point<2> &Fs = point<2>(0),
@@ -43,7 +51,7 @@ namespace SigmaTransform {
             const std::vector<point<2>> &steps = std::vector<point<2>>(0),
             actFunc<2> act = minus<2>
         );
-        SigmaTransform2D(
+        BasicSigmaTransform2D(
             diffFunc<2> sigma = NULL,
             const point<2> &width = 0,
             const point<2> &Fs = point<2>(0),
@@ -53,20 +61,25 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicSigmaTransform2D<double>  SigmaTransform2D;
+    typedef BasicSigmaTransform2D<float>   SigmaTransform2Df;
+
     /** Class STFT2D is a two-dimensional STFT-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the (2D-)identity.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class STFT2D : public SigmaTransform<2> {
-        public: STFT2D(
+    template<class T = double>
+    class BasicSTFT2D : public SigmaTransform<2,T> {
+        public: BasicSTFT2D(
             winFunc<2> window = NULL,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        STFT2D(
+        BasicSTFT2D(
             const point<2> &width,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
@@ -74,22 +87,27 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicSTFT2D<double>  STFT2D;
+    typedef BasicSTFT2D<float>   STFT2Df;
+
     /** Class WaveletTransform2D is a two-dimensional Wavelet-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the (2D-binary) logarithm.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class WaveletTransform2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicWaveletTransform2D : public SigmaTransform<2,T> {
 
         public:
-        WaveletTransform2D(
+        BasicWaveletTransform2D(
             winFunc<2> window = NULL,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        WaveletTransform2D(
+        BasicWaveletTransform2D(
             const point<2> &width,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
@@ -97,23 +115,28 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicWaveletTransform2D<double>  WaveletTransform2D;
+    typedef BasicWaveletTransform2D<float>   WaveletTransform2Df;
+
 
     /** Class SIM2D is a two-dimensional SIM(2)-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the 2D polar diffeomorphism.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class SIM2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicSIM2D : public SigmaTransform<2,T> {
 
         public:
-        SIM2D(
+        BasicSIM2D(
             winFunc<2> window = NULL,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        SIM2D(
+        BasicSIM2D(
             const point<2> &width,
             const point<2> &Fs = point<2>(0),
             const point<2> &size = point<2>(0),
@@ -121,23 +144,28 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicSIM2D<double>  SIM2D;
+    typedef BasicSIM2D<float>   SIM2Df;
+
     /** Class Curvelet2D is a two-dimensional Curvelet-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the 2D polar diffeomorphism
     *   and the "group action"-handle to a "parabolic shift".
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class Curvelet2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicCurvelet2D : public SigmaTransform<2,T> {
 
         public:
-        Curvelet2D(
+        BasicCurvelet2D(
             winFunc<2> window       = NULL,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        Curvelet2D(
+        BasicCurvelet2D(
             const point<2> &width,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
@@ -145,22 +173,27 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicCurvelet2D<double>  Curvelet2D;
+    typedef BasicCurvelet2D<float>   Curvelet2Df;
+
     /** Class NPShearlet2D is a two-dimensional Shearlet-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the 2D Shearing diffeomorphism.
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class NPShearlet2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicNPShearlet2D : public SigmaTransform<2,T> {
 
         public:
-        NPShearlet2D(
+        BasicNPShearlet2D(
             winFunc<2> window       = NULL,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        NPShearlet2D(
+        BasicNPShearlet2D(
             const point<2> &width,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
@@ -168,29 +201,38 @@ namespace SigmaTransform {
         );
     };
 
+    // precompiled in double and float precision
+    typedef BasicNPShearlet2D<double>  NPShearlet2D;
+    typedef BasicNPShearlet2D<float>   NPShearlet2Df;
+
     /** Class NPShearlet2D is a two-dimensional Shearlet-instantation of SigmaTransform<N>,
     *   by setting the spectral diffeomorphism's handle to the 2D Shearing diffeomorphism
     *   and the "group action"-handle to a "parabolic shift".
-    *   Since no more templates are involved, it can be used in a precompiled form.
+    *   It is precompiled in double and float precision, see the typedefs below.
     *
     *   See the documentation of SigmaTransform<N> for more information.
     */
-    class Shearlet2D : public SigmaTransform<2> {
+    template<class T = double>
+    class BasicShearlet2D : public SigmaTransform<2,T> {
 
         public:
-        Shearlet2D(
+        BasicShearlet2D(
             winFunc<2> window       = NULL,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
-        Shearlet2D(
+        BasicShearlet2D(
             const point<2> &width,
             const point<2> &Fs      = point<2>(0),
             const point<2> &size    = point<2>(0),
             const std::vector<point<2>> &steps = std::vector<point<2>>(0)
         );
     };
+
+    // precompiled in double and float precision
+    typedef BasicShearlet2D<double>  Shearlet2D;
+    typedef BasicShearlet2D<float>   Shearlet2Df;
 } // namespace SigmaTransform
 
 #endif //SIGMATRANSFORM1D_H
@@ -11,11 +11,20 @@
 #include <algorithm>
 #include <mutex>
 #include <functional>
+#include <typeinfo>
+#include <cstdint>
 #include <fftw3.h>
 
 #define DEBUG
 
 #include "SigmaTransform_util.h"
+#include "SigmaTransform_fftw.h"
+#include "SigmaTransform_pool.h"
+#include "SigmaTransform_bank.h"
+#include "SigmaTransform_functors.h"
+#include "SigmaTransform_simd.h"
+#include "SigmaTransform_file.h"
+#include "SigmaTransform_workspace.h"
 
 namespace SigmaTransform {
 
@@ -29,12 +38,22 @@ namespace SigmaTransform {
 
     /** Class template for the N-dimensional SigmaTransform.
     *
+    *   The scalar type "T" (double or float) sets the precision of the windows, the coefficients,
+    *   the reconstruction and the FFTs (fftw_* or fftwf_*), while the domains and the function
+    *   handles are always evaluated in double precision.
+    *
     *   Specific instantations are also derived.
     */
-    template<size_t N>
+    template<size_t N, class T = double>
     class SigmaTransform {
 
         public:
+            // complex scalars and vectors of the transform's precision
+            using cmpx          = std::complex<T>;
+            using cxVec         = std::vector<cmpx>;
+            using rVec          = std::vector<T>;
+            using fftwComplex   = typename FFTW<T>::complex;
+
             /** Constructor, taking the width of a warped Gaussian window instead of a function handle.
              *
              *  @param  sigma       a function handle for the spectral diffeomorphism, NULL for identity (STFT in N dimensions)
@@ -61,21 +80,87 @@ namespace SigmaTransform {
              */
             SigmaTransform( diffFunc<N> sigma=NULL, winFunc<N> window=NULL, const point<N> &Fs=point<N>(0), const point<N> &size=point<N>(0),
                             const std::vector<point<N>> &steps=std::vector<point<N>>(0), actFunc<N> action=minus<N> , int const& numThreads = 4 )
-            : m_window(window),m_sigma(sigma?sigma:id<N>),m_action(action?action:minus<N>),m_windows(0),m_coeff(0),m_reconstructed(0),
-              m_size(size),m_fs(Fs) , m_winWidth(0.0) {
+            : m_window(window),m_sigma(sigma?sigma:id<N>),m_action(action?action:minus<N>),m_windows(std::make_shared<WindowBank<N,T>>()),m_coeff(0),m_reconstructed(0),m_batchSize(0),
+              m_size(size),m_fs(Fs) , m_domain(std::make_shared<pointArray<N>>()) , m_winWidth(0.0) , m_supportThreshold(0.0) , m_windowsValid(false) , m_plannerFlags(FFTW_ESTIMATE) ,
+              m_decimated(false) , m_hop(0) , m_fusedBytes(0) , m_stepOversampling(0) , m_separable(false) , m_lazyWindows(false) , m_pool(ThreadPool::shared(numThreads)) , m_customPool(false) ,
+              m_workspace(std::make_shared<Workspace<N,T>>()) {
+                // batch forms of the built-in functions
+                m_sigmaBatch  = batchForm( m_sigma );
+                m_actionBatch = batchForm( m_action );
+                m_windowBatch = batchForm( m_window );
                 setSteps( steps );
-                if( !fftw_init_threads() )
-                    std::cerr << "thread error\n";
+                // initializes FFTW's threads, once per process
+                BasicFFTPlanCache<T>::instance();
                 setNumThreads( numThreads );
             }
 
+            /** Copy constructor, creating a context of a transform, e.g. one for each thread serving requests.
+             *
+             *  The context shares the read-only window bank and the warped domain with "plan" (and, as every transform,
+             *  the process-wide FFTW plans), but has a workspace, coefficients and a reconstruction of its own. Hence,
+             *  the contexts of a plan may be used concurrently, while the windows are held only once. Call "prepare" on
+             *  the plan first, else each context generates windows of its own. A setter invalidating the windows of a
+             *  context makes it generate a new bank, leaving the shared one untouched.
+             *
+             *  The context also shares the thread pool of "plan". While one context runs a parallel loop on the pool,
+             *  the loops of the others run serially in their calling threads. Hence, with one context per serving
+             *  thread, set each context to a single thread ("setNumThreads( 1 )"), or give it a pool of its own.
+             *
+             *  @param  plan        the transform to share the windows with
+             */
+            SigmaTransform( SigmaTransform const& plan )
+            : m_window(plan.m_window),m_sigma(plan.m_sigma),m_action(plan.m_action),
+              m_sigmaBatch(plan.m_sigmaBatch),m_actionBatch(plan.m_actionBatch),m_windowBatch(plan.m_windowBatch),
+              m_lazyWindow(plan.m_lazyWindow),m_lazyWindowBatch(plan.m_lazyWindowBatch),m_windowFactors(plan.m_windowFactors),
+              m_windows(plan.m_windows),m_coeff(0),m_reconstructed(0),m_batchSize(0),
+              m_size(plan.m_size),m_fs(plan.m_fs),m_steps(plan.m_steps),m_domain(plan.m_domain),m_numThreads(plan.m_numThreads),
+              m_winWidth(plan.m_winWidth),m_supportThreshold(plan.m_supportThreshold),m_windowsValid(plan.m_windowsValid),
+              m_plannerFlags(plan.m_plannerFlags),m_decimated(plan.m_decimated),m_hop(plan.m_hop),
+              m_coeffLength(plan.m_coeffLength),m_coeffOffset(plan.m_coeffOffset),m_fusedBytes(plan.m_fusedBytes),
+              m_stepOversampling(plan.m_stepOversampling),m_separable(plan.m_separable),m_lazyWindows(plan.m_lazyWindows),
+              m_windowCache(plan.m_windowCache),m_windowCacheTag(plan.m_windowCacheTag),m_pool(plan.m_pool),m_customPool(plan.m_customPool),
+              m_workspace(std::make_shared<Workspace<N,T>>()),m_jobQueue(plan.m_jobQueue) { }
+
+            // waits for the queued jobs, dropping their exceptions
+            virtual ~SigmaTransform() { m_jobs.wait(); }
+
             /** Setter method for the window function handle.
              *
              *  @param  window      a function handle for the window function, NULL for warped Gaussian
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setWindow( winFunc<N> window ) { m_window = window; return *this; }
+            SigmaTransform& setWindow( winFunc<N> window ) { m_window = window; m_windowBatch = batchForm( window ); m_windowFactors = std::array<winFunc<1>,N>(); m_windowsValid = false; return *this; }
+
+            /** Setter method for the window function handle, together with its batch form, which evaluates the window
+             *  at many points in a single call. Both have to compute the same values.
+             *
+             *  @param  window      a function handle for the window function, NULL for warped Gaussian
+             *  @param  windowBatch a function handle for the batch form, NULL to evaluate "window" point by point
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setWindow( winFunc<N> window , winBatchFunc<N> windowBatch ) {
+                m_window = window; m_windowBatch = window ? windowBatch : NULL; m_windowFactors = std::array<winFunc<1>,N>(); m_windowsValid = false; return *this;
+            }
+
+            /** Setter method for a separable window, given by its factors along each axis, i.e. the window is
+             *  window( x ) = factors[0]( x[0] ) * ... * factors[N-1]( x[N-1] ). The factors are used by the separable
+             *  mode, see "setSeparable".
+             *
+             *  @param  factors     function handles for the 1D windows along each axis
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setWindowFactors( std::array<winFunc<1>,N> const& factors ) {
+                m_window = [factors]( point<N> const& x ) {
+                    std::complex<double> w( 1 );
+                    for( int k = 0 ; k < N ; ++k )
+                        w *= factors[k]( point<1>( x[k] ) );
+                    return w;
+                };
+                m_windowBatch = NULL; m_windowFactors = factors; m_windowsValid = false; return *this;
+            }
 
             /** Setter method for the spectral diffeomorphism function handle.
              *
@@ -83,7 +168,19 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setSigma( diffFunc<N> sigma ) { m_sigma = sigma?sigma:id<N>; return *this;  }
+            SigmaTransform& setSigma( diffFunc<N> sigma ) { m_sigma = sigma?sigma:id<N>; m_sigmaBatch = batchForm( m_sigma ); m_windowsValid = false; return *this;  }
+
+            /** Setter method for the spectral diffeomorphism function handle, together with its batch form, which warps
+             *  many points in a single call. Both have to compute the same values.
+             *
+             *  @param  sigma       a function handle for the spectral diffeomorphism, NULL for identity (STFT in N dimensions)
+             *  @param  sigmaBatch  a function handle for the batch form, NULL to apply "sigma" point by point
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setSigma( diffFunc<N> sigma , diffBatchFunc<N> sigmaBatch ) {
+                setSigma( sigma ); if( sigma ) m_sigmaBatch = sigmaBatch; return *this;
+            }
 
             /** Setter method for the action function handle.
              *
@@ -91,7 +188,19 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setAction( actFunc<N> action ) { m_action = action?action:minus<N>; return *this; }
+            SigmaTransform& setAction( actFunc<N> action ) { m_action = action?action:minus<N>; m_actionBatch = batchForm( m_action ); m_windowsValid = false; return *this; }
+
+            /** Setter method for the action function handle, together with its batch form, which acts on many points
+             *  in a single call. Both have to compute the same values.
+             *
+             *  @param  action      a function handle for the "group action" performed in the warped Fourier domain, NULL for "subtraction"
+             *  @param  actionBatch a function handle for the batch form, NULL to apply "action" point by point
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setAction( actFunc<N> action , actBatchFunc<N> actionBatch ) {
+                setAction( action ); if( action ) m_actionBatch = actionBatch; return *this;
+            }
 
             /** Setter method for the sampling frequency
              *
@@ -99,7 +208,7 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setFs( const point<N> &Fs ) { m_fs = Fs; return *this; }
+            SigmaTransform& setFs( const point<N> &Fs ) { m_fs = Fs; m_windowsValid = false; return *this; }
 
             /** Setter method for the signal size
              *
@@ -107,7 +216,7 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setSize( const point<N> &size ) { m_size = size; return *this; }
+            SigmaTransform& setSize( const point<N> &size ) { m_size = size; m_windowsValid = false; return *this; }
 
             /** Setter method for the window width
              *
@@ -115,16 +224,213 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setWinWidth( const double& winWidth ) { m_window = NULL; m_winWidth = winWidth; return *this; }
+            SigmaTransform& setWinWidth( const double& winWidth ) {
+                m_window = NULL; m_windowBatch = NULL; m_windowFactors = std::array<winFunc<1>,N>(); m_winWidth = winWidth; m_windowsValid = false; return *this;
+            }
+
+            /** Setter method for the threshold, below which window samples are regarded as zero
+             *
+             *  @param  threshold   samples with modulus <= threshold * (maximal modulus of the window) are dropped
+             *                      from the window bank; defaults to 0, i.e. only exact zeros are dropped
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setSupportThreshold( const double& threshold ) { m_supportThreshold = threshold; m_windowsValid = false; return *this; }
+
+            /** Setter method for the rounding of the steps of shift-structured transforms, i.e. with the identity as
+             *  diffeomorphism and subtraction as action (e.g. the STFT), whose windows are shifts of one prototype.
+             *
+             *  @param  oversampling    if > 0, each step is rounded to the nearest multiple of 1/oversampling of the spacing of
+             *                          the Fourier grid, such that the windows of all channels are copied from at most
+             *                          oversampling^N evaluations of the prototype; if 0 (default), the windows are exact and
+             *                          only channels whose steps differ by whole grid points share a prototype
+             *
+             *  @return                 reference to the SigmaTransform-object
+             */
+            SigmaTransform& setStepOversampling( const int& oversampling ) { m_stepOversampling = oversampling; m_windowsValid = false; return *this; }
+
+            /** Setter method for the separable mode, in which the window bank stores the 1D factors of the windows along
+             *  each axis, instead of the N-D windows; the N-D windows are formed on the fly, row by row, while they are
+             *  multiplied with the spectrum or the coefficients. Then, the bank holds sum( size[k] * steps[k] ) instead of
+             *  prod( size ) * #steps samples, where steps[k] is the number of distinct coordinates of the steps along axis k.
+             *
+             *  @param  separable   if true, the windows are stored separably; this requires an axis-wise diffeomorphism
+             *                      ("id", "logabs" or "logpos"), the action "minus" or "plus" and a separable window, i.e.
+             *                      a warped Gaussian, "gauss" or a window given by "setWindowFactors"; defaults to false
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setSeparable( const bool& separable ) { m_separable = separable; m_windowsValid = false; return *this; }
+
+            /** Setter method for the lazy mode, in which the window bank keeps only the supports of the windows: each
+             *  window is evaluated again on the warped Fourier domain, whenever a channel is analyzed or synthesized,
+             *  into a scratch buffer of the thread. This trades the memory of the windows, which is as large as that
+             *  of the (non-decimated) coefficients, for their recomputation. The separable mode takes precedence.
+             *
+             *  @param  lazy        if true, the windows are evaluated on the fly; defaults to false
+             *                      NOTE:   in lazy mode, the synthesis sums up the channels of each thread on a
+             *                              spectrum of its own, see "multiplier"
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setLazyWindows( const bool& lazy ) { m_lazyWindows = lazy; m_windowsValid = false; return *this; }
+
+            /** Setter method for a cache file of the window bank. When the windows are due, the bank is mapped from the
+             *  file (see "WindowBank::map"), if the file matches the transform, i.e. the dimension, precision, size, Fs,
+             *  steps and the fingerprint of the remaining parameters (see "windowFingerprint"); otherwise, the windows are
+             *  generated and written to the file, for the next run. A mapped bank is used as is, without copying it, and
+             *  its pages are shared by all processes mapping the same file. Not used in lazy mode.
+             *
+             *  @param  filename    the name of the cache file; an empty name (default) disables the cache
+             *  @param  tag         a string identifying the handles beyond their types, added to the fingerprint
+             *                      NOTE:   the fingerprint identifies function objects (e.g. lambdas) by their type only;
+             *                              parameters captured by them, e.g. the width of a window, have to be encoded
+             *                              in the tag, otherwise windows of different parameters may be mapped
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setWindowCache( std::string const& filename , std::string const& tag = "" ) {
+                m_windowCache = filename; m_windowCacheTag = tag; m_windowsValid = false; return *this;
+            }
+
+            /** Returns a fingerprint of the parameters, which determine the window bank besides the dimension, precision,
+             *  size, Fs and steps: the dynamic type of the transform, the tag of "setWindowCache", the diffeomorphism, the
+             *  action and the window (or its factors, or the width of the warped Gaussian), the support threshold, the step
+             *  oversampling and the separable mode. Function pointers are identified by their address relative to "id",
+             *  which is stable between runs of the same executable, and function objects by their type.
+             *
+             *  @return             the fingerprint
+             */
+            uint64_t windowFingerprint() const {
+                Fingerprint fp;
+                fp.add( typeid( *this ).name() ).add( m_windowCacheTag );
+                addHandle( fp , m_sigma );
+                addHandle( fp , m_action );
+                addHandle( fp , m_window );
+                for( int k = 0 ; k < N ; ++k )
+                    addHandle( fp , m_windowFactors[k] );
+                // the width of the warped Gaussian, as it is going to be used
+                point<N> width = m_winWidth;
+                bool     unset = true;
+                for( int k = 0 ; k < N ; ++k )
+                    unset = unset && m_winWidth[k] == 0.0;
+                if( unset )
+                    width = point<N>( 8.0 );
+                return fp.add( width ).add( m_supportThreshold ).add( m_stepOversampling ).add( m_separable ).value();
+            }
+
+            /** Setter method for the decimation of the coefficients (painless nonstationary mode)
+             *
+             *  @param  decimated   if true, the coefficients of each channel are computed on a lattice with the length of the
+             *                      window's support in the Fourier domain, instead of the full signal size; since the windows
+             *                      are stored on their supports only, this requires a support threshold > 0 for windows
+             *                      without exact zeros, e.g. warped Gaussians, see "setSupportThreshold"
+             *  @param  hop         if nonzero, every channel uses a lattice of ceil(size[k]/hop[k]) points along axis k,
+             *                      or the length of the window's support, if that is larger; defaults to 0
+             *                      NOTE:   the mode applies from the next analysis on, so coefficients should be
+             *                              synthesized before it is changed
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setDecimation( const bool& decimated , const point<N>& hop = point<N>(0) ) { m_decimated = decimated; m_hop = hop; return *this; }
+
+            /** Setter method for the fused execution of the analysis
+             *
+             *  @param  fused       if true, each thread multiplies a block of channels with the spectrum and inverse
+             *                      transforms it right away, using a single-threaded plan, while the block is still
+             *                      in the cache; if false, all channels are transformed by one multi-threaded FFT at the end
+             *  @param  cacheBytes  the size of the blocks in bytes, i.e. the cache size per thread; defaults to 256 KiB
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setFused( const bool& fused , const size_t& cacheBytes = 256*1024 ) { m_fusedBytes = fused ? cacheBytes : 0; return *this; }
 
             /** Setter method for the number of threads
+             *
+             *  The process-wide pool of the transform is switched to one of matching size. A pool set by "setThreadPool"
+             *  is kept, and its threads work on "numThreads" blocks per parallel loop.
              *
              *  @param  numThreads  the number of threads used for parallel processing (multiplications, additions as well as for FFTW), defaults to 4
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& setNumThreads( const int &numThreads )
-                { m_numThreads = numThreads ; fftw_plan_with_nthreads(numThreads); return *this; }
+            SigmaTransform& setNumThreads( const int &numThreads ) {
+                m_numThreads = numThreads;
+                // switch to a process-wide pool of matching size, unless a pool was set or threads are spawned per call
+                if( m_pool && !m_customPool && m_pool->size() != numThreads )
+                    m_pool = ThreadPool::shared( numThreads );
+                return *this;
+            }
+
+            /** Setter method for the pool of worker threads
+             *
+             *  @param  pool        shared pointer to a thread pool, which may be shared with other SigmaTransform-objects;
+             *                      the number of threads is set to the size of the pool, and the pool is kept by later
+             *                      calls to "setNumThreads".
+             *                      If NULL, threads are spawned and joined for every parallel operation.
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setThreadPool( std::shared_ptr<ThreadPool> pool ) {
+                m_pool       = pool;
+                m_customPool = (bool) pool;
+                if( pool ) {
+                    m_numThreads = pool->size();
+                }
+                return *this;
+            }
+
+            /** Getter method for the pool of worker threads
+             *
+             *  @return             shared pointer to the thread pool, NULL if threads are spawned per call
+             */
+            std::shared_ptr<ThreadPool> getThreadPool() { return m_pool; }
+
+            /** Setter method for the workspace, holding the scratch buffers of the transforms
+             *
+             *  @param  workspace   shared pointer to a workspace, which may be shared with other SigmaTransform-objects,
+             *                      as long as they are not used at the same time. If NULL, the object gets a workspace
+             *                      of its own (default).
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setWorkspace( std::shared_ptr<Workspace<N,T>> workspace ) {
+                m_workspace = workspace ? workspace : std::make_shared<Workspace<N,T>>();
+                return *this;
+            }
+
+            /** Getter method for the workspace
+             *
+             *  @return             shared pointer to the workspace
+             */
+            std::shared_ptr<Workspace<N,T>> getWorkspace() { return m_workspace; }
+
+            /** Setter method for the queue running the asynchronous jobs, see "analyzeAsync"
+             *
+             *  @param  queue       shared pointer to a job queue, which may be shared with other SigmaTransform-objects;
+             *                      if NULL, the process-wide queue with one worker per core is used (default)
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setJobQueue( std::shared_ptr<JobQueue> queue ) {
+                m_jobQueue = queue;
+                return *this;
+            }
+
+            /** Getter method for the queue running the asynchronous jobs
+             *
+             *  @return             shared pointer to the job queue, NULL if none was used or set yet
+             */
+            std::shared_ptr<JobQueue> getJobQueue() { return m_jobQueue; }
+
+            /** Setter method for the rigor of the FFTW planner
+             *
+             *  @param  flags       the planner flags, e.g. FFTW_ESTIMATE (default), FFTW_MEASURE or FFTW_PATIENT;
+             *                      plans are cached process-wide, see FFTPlanCache
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& setPlannerRigor( const unsigned &flags ) { m_plannerFlags = flags; return *this; }
 
             /** Setter method for the channels used in the warped Fourier domain
              *
@@ -148,11 +454,11 @@ namespace SigmaTransform {
                     for( int k = 0 ; k < N ; ++k ) {
                         stps[k] = linspace( -m_fs[k] / 2.0 , m_fs[k] / 2.0 , steps[0][k] );
                     }
-                    m_steps = meshgridN( stps );
+                    m_steps = meshgridN( stps , m_pool.get() );
                     // get boundary  points of warped domain
                     point<N> maxi,mini; maxi=mini=m_steps[0];
+                    warpPoints( m_steps.data() , m_steps.size() );
                     for( auto& step : m_steps ) {
-                        step = m_sigma( step );
                         for( int k = 0 ; k < N ; ++k ) {
                             maxi[k]     = (step[k]>maxi[k])?step[k]:maxi[k];
                             mini[k]     = (step[k]<mini[k])?step[k]:mini[k];
@@ -163,10 +469,12 @@ namespace SigmaTransform {
                     for( int k = 0 ; k < N ; ++k ) {
                         stps[k] = linspace( mini[k] , maxi[k] , steps[0][k] );
                     }
-                    m_steps = meshgridN( stps );
+                    m_steps = meshgridN( stps , m_pool.get() );
                 } else {
                     m_steps = steps;
                 }
+                // windows depend on the steps
+                m_windowsValid = false;
 
                 return *this;
             }
@@ -177,11 +485,52 @@ namespace SigmaTransform {
              */
             cxVec& getCoeffs(){ return m_coeff; }
 
+            /** Getter method for the offsets of the channels in the coefficient-vector.
+             *
+             *  @return             reference to a vector of "m_steps.size()+1" offsets, the last one being the total size
+             */
+            std::vector<size_t> const& getCoeffOffsets(){ return m_coeffOffset; }
+
+            /** Getter method for the size of a channel's coefficients, i.e. the full signal size or,
+             *  if decimated, the size of the channel's lattice.
+             *
+             *  @param  channel     the number of the channel
+             *
+             *  @return             the size in N dimensions
+             */
+            point<N> getCoeffSize( int const& channel ){
+                point<N> sz;
+                for( int k = 0 ; k < N ; ++k )
+                    sz[k] = m_coeffLength[channel][k];
+                return sz;
+            }
+
             /** Getter method for the spectrum of the windows
              *
-             *  @return             reference to the spectrums of the used windows
+             *  @return             the spectrums of the used windows, expanded to the whole Fourier domain
+             */
+            cxVec getWindows(){
+                if( !isLazy() )
+                    return m_windows->dense();
+                // evaluate the windows, keeping the samples on their supports
+                prepare();
+                size_t sigsize = m_size.prod();
+                cxVec               out( sigsize * m_steps.size() );
+                WindowScratch<N,T>  win;
+                for( int j = 0 ; j < m_steps.size() ; ++j ) {
+                    cmpx* dense = out.data() + j*sigsize;
+                    forEachWindowRun( j , sizeArray() , win , [&]( const cmpx* w , const T* , size_t const& index , size_t const& , int const& len ) {
+                        std::copy( w , w + len , dense + index );
+                    } );
+                }
+                return out;
+            }
+
+            /** Getter method for the window bank, holding the spectrum of the windows on their supports
+             *
+             *  @return             reference to the window bank
              */
-            cxVec& getWindows(){ return m_windows; }
+            WindowBank<N,T> const& getWindowBank(){ return *m_windows; }
 
             /** Getter method for the reconstruction
              *
@@ -189,6 +538,30 @@ namespace SigmaTransform {
              */
             cxVec& getReconstruction(){ return m_reconstructed; }
 
+            /** Getter method for the real reconstruction, see "synthesizeReal"
+             *
+             *  @return             reference to the real part of the reconstructed signal
+             */
+            rVec& getReconstructionReal(){ return m_reconstructedReal; }
+
+            /** Getter method for the coefficients of a batch, see "analyzeBatch"
+             *
+             *  @return             reference to the coefficients of all signals, one after another
+             */
+            cxVec& getBatchCoeffs(){ return m_batchCoeff; }
+
+            /** Getter method for the reconstructions of a batch, see "synthesizeBatch"
+             *
+             *  @return             reference to the reconstructed signals, one after another
+             */
+            cxVec& getBatchReconstruction(){ return m_batchReconstructed; }
+
+            /** Getter method for the number of signals of the last batch, see "analyzeBatch"
+             *
+             *  @return             the number of signals
+             */
+            int getBatchSize(){ return m_batchSize; }
+
             /** Functor operator, wrapping "analyze".
              *
              *  @param  sig         the signal as a complex vector
@@ -201,8 +574,8 @@ namespace SigmaTransform {
              *
              *  @param  sig         the signal as a complex vector
              *  @param  onFinish    a callback-function to be called, when the work is done; defaults to NULL
-             *                      NOTE:   if NOT NULL: the transform is executed asynchronously in a separate thread
-             *                                           and the function returns immediately
+             *                      NOTE:   if NOT NULL: the transform is queued as a job (see "analyzeAsync")
+             *                                           and the function returns immediately; see "join"
              *                              if NULL:     the transfom is executed synchronously and blocks till finish
              *
              *  @return             reference to the SigmaTransform-object
@@ -210,59 +583,205 @@ namespace SigmaTransform {
              *  @throws             std::runtime_error
              */
             SigmaTransform& analyze( cxVec const& sig , std::function<void(SigmaTransform*)> onFinish = NULL ) {
-                if( !m_steps.size() ) {
-                    throw std::runtime_error("steps not set");
-                }
-                if( !m_fs.prod() ) {
-                    throw std::runtime_error("Fs not set");
-                }
-                if( !m_size.prod() ) {
-                    throw std::runtime_error("size not set");
-                }
+                checkParameters();
                 return (onFinish) ? asyncTransform( sig , onFinish ) : applyTransform( sig );
             }
 
+            /** Analyze a real signal, using a real-to-complex FFT, which computes only half of the spectrum.
+             *
+             *  @param  sig         the signal as a real vector
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error
+             */
+            SigmaTransform& analyze( rVec const& sig ) {
+                checkParameters();
+                // the spectrum, in the workspace
+                typename Workspace<N,T>::alignedVec& spec = workspace().spectrum;
+                spec.resize( sig.size() );
+                fftReal( sig , spec.data() );
+                return applyTransformSpectrum( spec.data() );
+            }
+
             /** synthesize from the coefficients, using the (complex conjugated) spectrum of the generated windows.
              *
              *  @param  onFinish    a callback-function to be called, when the work is done; defaults to NULL
-             *                      NOTE:   if NOT NULL: the inverse transform is executed asynchronously in a separate thread
-             *                                           and the function returns immediately
+             *                      NOTE:   if NOT NULL: the inverse transform is queued as a job (see "analyzeAsync")
+             *                                           and the function returns immediately; see "join"
              *                              if NULL:     the inverse transfom is executed synchronously and blocks till finish
              *
              *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error, if no signal was analyzed with the current windows
              */
             SigmaTransform& synthesize( std::function<void(SigmaTransform* obj)> onFinish = NULL ){
                 return (onFinish) ? asyncInverseTransform( onFinish ) : applyInverseTransform( );
             }
 
+            /** synthesize the real part of the signal from the coefficients, using a complex-to-real FFT, which
+             *  needs only half of the spectrum. For real signals and windows, which are symmetric in the Fourier
+             *  domain (e.g. the STFT), this is the reconstruction. The result is held by "getReconstructionReal".
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error, if no signal was analyzed with the current windows
+             */
+            SigmaTransform& synthesizeReal() {
+                // convenient vars
+                std::array<int,N> n = sizeArray();
+                size_t sigsize = m_size.prod(), h0 = n[0]/2 + 1, rows = sigsize / n[0];
+                // spectrum of the reconstruction, in the workspace
+                Workspace<N,T>& ws = workspace();
+                typename Workspace<N,T>::alignedVec &spec = ws.spectrum, &half = ws.half;
+                spec.resize( sigsize );
+                accumulateSpectrum( spec.data() );
+                // Hermitian part on the non-redundant half, H[k] = ( R[k] + conj( R[-k] ) ) / 2
+                half.resize( h0 * rows );
+                forEachMirroredRow( [&]( size_t const& row , size_t const& mirror ) {
+                    const cmpx* R  = spec.data() + row*n[0];
+                    const cmpx* Rm = spec.data() + mirror*n[0];
+                    for( int k = 0 ; k < h0 ; ++k ) {
+                        half[row*h0 + k] = ( R[k] + conj( Rm[(n[0]-k) % n[0]] ) ) / (T) 2;
+                    }
+                } );
+                // transform back
+                m_reconstructedReal.resize( sigsize );
+                int sz[N];
+                for( int k = 0 ; k < N ; ++k )  sz[N-1-k] = n[k];
+                fftwComplex* in = reinterpret_cast<fftwComplex*>( half.data() );
+                FFTW<T>::execute_dft_c2r( BasicFFTPlanCache<T>::instance().getC2R( N , sz , 1 , in , m_reconstructedReal.data() ,
+                                                                                   m_plannerFlags , m_numThreads ) ,
+                                          in , m_reconstructedReal.data() );
+                // return
+                return *this;
+            }
+
+            /** Analyzes a batch of "howmany" signals of the transform's size, stored one after another.
+             *
+             *  The spectra of all signals are computed by a single FFTW plan, and the pairs of channels and signals are
+             *  split among the threads, such that the cost per signal is little more than its arithmetic. The coefficients
+             *  are held by "getBatchCoeffs": those of signal m start at m * getCoeffOffsets().back() and have the layout
+             *  of "getCoeffs", i.e. the tensor [howmany][steps][size], unless decimated. "getCoeffs" is not updated.
+             *
+             *  @param  sigs        pointer to the signals, i.e. to "howmany" times the signal size samples
+             *  @param  howmany     the number of signals
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error
+             */
+            SigmaTransform& analyzeBatch( const cmpx* sigs , int const& howmany ) {
+                checkParameters();
+                if( howmany < 1 ) {
+                    throw std::runtime_error("Number of signals must be positive.");
+                }
+                // the spectra of all signals at once, in the workspace
+                typename Workspace<N,T>::alignedVec& spec = workspace().spectrum;
+                spec.resize( m_size.prod() * howmany );
+                fftN( reinterpret_cast<fftwComplex*>( spec.data() ) , reinterpret_cast<fftwComplex*>( const_cast<cmpx*>( sigs ) ) ,
+                      m_size , howmany , FFTW_FORWARD );
+                transformSpectra( spec.data() , howmany , m_batchCoeff );
+                m_batchSize = howmany;
+                return *this;
+            }
+
+            /** Analyzes a batch of signals of the transform's size, stored one after another, see above.
+             *
+             *  @param  sigs        the signals as a complex vector, whose size is a multiple of the signal size
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error
+             */
+            SigmaTransform& analyzeBatch( cxVec const& sigs ) {
+                checkParameters();
+                size_t sigsize = m_size.prod();
+                if( !sigs.size() || sigs.size() % sigsize ) {
+                    throw std::runtime_error("Size of the batch is not a multiple of the signal size.");
+                }
+                return analyzeBatch( sigs.data() , sigs.size() / sigsize );
+            }
+
+            /** Synthesizes the batch of signals from the coefficients of "analyzeBatch", which may have been altered
+             *  in place. The reconstructions are held by "getBatchReconstruction", one after another.
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error
+             */
+            SigmaTransform& synthesizeBatch() {
+                if( !m_batchSize || m_batchCoeff.size() != m_coeffOffset.back() * m_batchSize ) {
+                    throw std::runtime_error("Size of the batch coefficients does not match, call analyzeBatch first.");
+                }
+                // sum up the channels in the Fourier domain, and transform all signals back at once
+                m_batchReconstructed.resize( m_size.prod() * m_batchSize );
+                accumulateSpectra( m_batchCoeff.data() , m_batchSize , m_batchReconstructed.data() );
+                ifft_inplace( m_batchReconstructed , m_batchSize );
+                return *this;
+            }
+
             /** Use transform as a multiplier; analyze, apply a mask and synthesize.
+             *
+             *  The channels are streamed: each thread analyzes, masks and synthesizes its channels one at a time,
+             *  such that the coefficients are never stored as a whole, see "applyMultiplier". Hence, "getCoeffs"
+             *  is not updated; use analyze( sig ).applyMask( mask ).synthesize(), if the coefficients are needed.
              *
              *  @param  sig         the signal as a complex vector
              *  @param  mask        the mask as a complex vector (of the same size as the coefficient-vector)
              *  @param  onFinish    a callback-function to be called, when the work is done; defaults to NULL
-             *                      NOTE:   if NOT NULL: the multiplier is executed asynchronously in a separate thread
-             *                                           and the function returns immediately
+             *                      NOTE:   if NOT NULL: the multiplier is queued as a job (see "analyzeAsync")
+             *                                           and the function returns immediately; see "join"
              *                              if NULL:     the multiplier is executed synchronously and blocks till finish
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @return             reference to the reconstructed signal
+             *
+             *  @throws             std::runtime_error
              */
             cxVec& multiplier( cxVec const& sig, cxVec const& mask, std::function<void(SigmaTransform*)> onFinish = NULL  ){
-                return (onFinish)?asyncMultiplier( sig, mask, onFinish ) : analyze(sig).applyMask(mask).synthesize().getReconstruction();
+                checkParameters();
+                if( onFinish ) {
+                    asyncMultiplier( sig, mask, onFinish );
+                } else {
+                    // error?
+                    prepare().makeCoeffLayout();
+                    if( mask.size() != m_coeffOffset.back() ) {
+                        throw std::runtime_error("Size of mask does not match size of coefficients.");
+                    }
+                    applyMultiplier( signalSpectrum( sig ) , [this,&mask]( int const& j , cmpx* coeff , LatticeDomain<N>& ) {
+                        // multiply with the j-th part of the mask
+                        ComplexKernels<T>::get().mul( coeff , mask.data() + m_coeffOffset[j] , m_coeffOffset[j+1] - m_coeffOffset[j] );
+                    } );
+                }
+                return m_reconstructed;
             }
 
-            /** Use transform as a multiplier; analyze, apply a mask and synthesize.
+            /** Use transform as a multiplier; analyze, apply a mask and synthesize, streaming the channels (see above).
              *
              *  @param  sig         the signal as a complex vector
              *  @param  maskFunc    complex function handle, taking spatial and warped Fourier domain parameters
              *  @param  onFinish    a callback-function to be called, when the work is done; defaults to NULL
-             *                      NOTE:   if NOT NULL: the multiplier is executed asynchronously in a separate thread
-             *                                           and the function returns immediately
+             *                      NOTE:   if NOT NULL: the multiplier is queued as a job (see "analyzeAsync")
+             *                                           and the function returns immediately; see "join"
              *                              if NULL:     the multiplier is executed synchronously and blocks till finish
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @return             reference to the reconstructed signal
+             *
+             *  @throws             std::runtime_error
              */
             cxVec& multiplier( cxVec const& sig, mskFunc<N> maskFunc, std::function<void(SigmaTransform*)> onFinish = NULL  ){
-                return (onFinish)?asyncMultiplier( sig, maskFunc, onFinish ) : analyze(sig).applyMask(maskFunc).synthesize().getReconstruction();
+                checkParameters();
+                if( onFinish ) {
+                    asyncMultiplier( sig, maskFunc, onFinish );
+                } else {
+                    applyMultiplier( signalSpectrum( sig ) , [this,&maskFunc]( int const& j , cmpx* coeff , LatticeDomain<N>& dom ) {
+                        // run thru all points of the channel's lattice
+                        for( auto const& x : latticeDomain( dom , m_coeffLength[j] ) ) {
+                            *coeff++ *= maskFunc( x , m_steps[j] );
+                        }
+                    } );
+                }
+                return m_reconstructed;
             }
 
             /** Multiplies the coefficients with a mask.
@@ -275,28 +794,21 @@ namespace SigmaTransform {
              */
             SigmaTransform& applyMask( const cxVec &mask ) {
                 // error?
+                checkCoefficients();
                 if( mask.size() != m_coeff.size() ) {
                     throw std::runtime_error("Size of mask does not match size of coefficients.");
                 }
-                // deallocate threads after leaving scope
-                std::unique_ptr<std::thread[]> _threads( new std::thread[m_numThreads] );
-                // start threads
-                int stepsPerThread = ceil( (double) (m_steps.size()) / m_numThreads );
-                for( int k = 0, stepsLeft = m_steps.size() ; k < m_numThreads ; ++k, stepsLeft -= stepsPerThread ) {
-                    _threads[k] = std::move( std::thread( [this,&stepsPerThread,&mask,stepsLeft,k]() {
-                        // get iterator from correct offset
-                        int offset = k*stepsPerThread*m_size.prod(),
-                            numval = ((stepsLeft>stepsPerThread)?stepsPerThread:stepsLeft)*m_size.prod();
-                        // multiply nth part of coeffs
-                        for( int i = 0 ; i < numval ; ++i ) {
-                            m_coeff[offset+i] *= mask[offset+i];
-                        }
-                    } ) );
-                }
-                // wait for all threads to finish
-                for( int k = 0 ; k < m_numThreads ; ++k ) {
-                    _threads[k].join();
-                }
+                // multiply the coefficients of each block of channels in parallel
+                ComplexKernels<T> const& K = ComplexKernels<T>::get();
+                parallelFor( m_steps.size() , [this,&mask,&K]( int const& firstStep , int const& numSteps ) {
+                    for( int j = firstStep ; j < firstStep + numSteps ; ++j ) {
+                        // coefficients of windows without support are zero
+                        if( !m_windows->getBand( j ).numel() )
+                            continue;
+                        // multiply j-th part of coeffs
+                        K.mul( m_coeff.data() + m_coeffOffset[j] , mask.data() + m_coeffOffset[j] , m_coeffOffset[j+1] - m_coeffOffset[j] );
+                    }
+                } );
                 // return
                 return *this;
             }
@@ -307,111 +819,520 @@ namespace SigmaTransform {
              *
              *  @return             reference to the SigmaTransform-object
              */
-            SigmaTransform& applyMask( mskFunc<N> maskFunc ) {
-                // spatial domain
-                auto spatialDom = makeSpatialDomain();
-                // deallocates itself after leaving scope
-                std::unique_ptr<std::thread[]> _threads( new std::thread[m_numThreads] );
-                // start threads
-                int stepsPerThread = ceil( (double) (m_steps.size()) / m_numThreads );
-                for( int k = 0, stepsLeft = m_steps.size() ; k < m_numThreads ; ++k, stepsLeft -= stepsPerThread ) {
-                    _threads[k] = std::move( std::thread( [this,&maskFunc,&spatialDom,&stepsPerThread,stepsLeft,k]() {
-                        // get offsets and iterator
-                        int  stepsOffset = stepsPerThread*k,
-                             numval      = (stepsLeft>stepsPerThread)?stepsPerThread:stepsLeft;
-                        auto coeff       = m_coeff.begin() + stepsOffset*m_size.prod();
-                        // run thru all points
-                        for( int i=0;i<numval;++i) {
-                            for( auto const& x : spatialDom ) {
-                                *coeff++ *= maskFunc( x , m_steps[stepsOffset+i] );
-                            }
-                        }
-                    } ) );
-                }
-                // wait for all threads to finish
-                for( int k = 0 ; k < m_numThreads ; ++k ) {
-                    _threads[k].join();
-                }
-                // return reference
+            SigmaTransform& applyMask( mskFunc<N> maskFunc ) { return applyMaskWith( maskFunc ); }
+
+            /** Creates the window bank, if it is not up to date with the current parameters.
+             *
+             *  The bank is kept between calls to "analyze" and is only regenerated after one of
+             *  the setters for the window, sigma, action, Fs, size, steps or window width was used.
+             *  Call this once at startup to avoid paying for the windows in the first transform.
+             *
+             *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             std::runtime_error
+             */
+            SigmaTransform& prepare() {
+                checkParameters();
+                if( !m_windowsValid )
+                    makeWindows();
                 return *this;
             }
 
-            /** Creates a set of "m_steps.size()" windows in the Fourier domain.
+            /** Creates a set of "m_steps.size()" windows in the Fourier domain, keeping only their supports, or maps them
+             *  from the cache file, see "setWindowCache".
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @return             void
+             *
+             *  @throws             std::runtime_error, if the cache file cannot be written
              */
             void makeWindows( ) {
+                bool     cached      = !m_windowCache.empty() && !isLazy();
+                uint64_t fingerprint = cached ? windowFingerprint() : 0;
+                // a new bank, since the current one may be shared with contexts, see the copy constructor
+                m_windows = std::make_shared<WindowBank<N,T>>();
+                // mapped from a previous run?
+                if( cached && m_windows->map( m_windowCache , sizeArray() , m_fs , m_steps , fingerprint ) ) {
+                    m_windowsValid = true;
+                    return;
+                }
+                generateWindows();
+                // keep them for the next run
+                if( cached )
+                    m_windows->save( m_windowCache , m_fs , m_steps , fingerprint );
+            }
+
+            /** Generates the windows, see "makeWindows".
+             *
+             *  @return             void
+             */
+            void generateWindows( ) {
+                // separable: only the factors
+                if( m_separable ) {
+                    makeSeparableWindows();
+                    m_windowsValid = true;
+                    return;
+                }
+                // check if window was given, else calculate good width for a warped gaussian window
+                winBatchFunc<N> windowBatch = m_windowBatch;
+                winFunc<N>      window      = m_window ? m_window : makeWarpedGaussian( windowBatch );
+                // shifts of a prototype?
+                if( isShiftStructured() && !m_lazyWindows ) {
+                    makeShiftedWindows( window , windowBatch );
+                    m_windowsValid = true;
+                    return;
+                }
                 // reserve space for windows..
-                m_windows.resize( m_size.prod() * m_steps.size() );
+                m_windows->reset( sizeArray() , m_steps.size() );
                 // make Domain
                 makeWarpedDomain();
-                // check if window was given, else calculate good width for a warped gaussian window
-                if( !m_window )
-                    makeWarpedGaussian();
-                // deallocates itself after leaving scope
-                std::unique_ptr<std::thread[]> _threads( new std::thread[m_numThreads] );
-                // start threads
-                int stepsPerThread = ceil( (double) (m_steps.size()) / m_numThreads );
-                for( int k = 0, stepsLeft = m_steps.size() ; k < m_numThreads ; ++k, stepsLeft -= stepsPerThread ) {
-                    _threads[k] = std::move( std::thread( [this,&stepsPerThread,k,stepsLeft]() {
-                        // get iterator from correct offset
-                        auto win = m_windows.begin() + k*stepsPerThread * m_size.prod();
-                        // create n-th part of the windows
-                        for( int i = 0 ; i < ((stepsLeft>stepsPerThread)?stepsPerThread:stepsLeft) ; ++i ) {
-                            for( auto const& x : m_domain ) {
-                                *win++ = m_window( m_action( x , m_steps[k*stepsPerThread + i] ) );
-                            }
-                        }
-                    } ) );
-                }
-                // wait for all threads to finish
-                for( int k = 0 ; k < m_numThreads ; ++k ) {
-                    _threads[k].join();
-                }
+                // create the windows of each block of channels in parallel
+                parallelFor( m_steps.size() , [this,&window,&windowBatch]( int const& firstStep , int const& numSteps ) {
+                    // dense window, one at a time
+                    WindowScratch<N,T> win;
+                    for( int j = firstStep ; j < firstStep + numSteps ; ++j ) {
+                        evaluateWindow( window , windowBatch , m_steps[j] , win );
+                        // keep the support, and the samples unless lazy
+                        if( m_lazyWindows )
+                            m_windows->setSupport( j , win.window.data() , m_supportThreshold );
+                        else
+                            m_windows->setChannel( j , win.window.data() , m_supportThreshold );
+                    }
+                } );
+                m_windows->finalize();
+                // lazy: keep the handles for evaluating the windows again
+                m_lazyWindow      = m_lazyWindows ? window : NULL;
+                m_lazyWindowBatch = m_lazyWindows ? windowBatch : NULL;
+                // windows are up to date now
+                m_windowsValid = true;
             }
 
-            /** Performs the analysis/transform asynchronously.
+            /** Adds a function handle to a fingerprint, see "windowFingerprint".
              *
-             *  @param  sig         signal as a complex vector
-             *  @param  onFinish    a callback-function to be called, when the work is done
+             *  @param  fp          the fingerprint
+             *  @param  f           the handle
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @return             void
              */
-            SigmaTransform& asyncTransform( cxVec const& sig, std::function<void(SigmaTransform*)> onFinish ) {
-                 m_threads.insert( std::make_pair<std::string,std::thread>( "Transform" , std::move( std::thread( [this,sig,onFinish]() {
-                    //std::cout << "Starting 'Transform' asynchronously."<<std::endl;
-                    // try to acquire mutex
-                    std::unique_lock<std::mutex> lk( m_mtx );
-                    //std::cout << "Acquired mutex in 'Transform'"<<std::endl;
-                    // transform asynchronously
-                    this->analyze( sig );
-                    // call callback
-                    onFinish( this );
-                } ) ) ) );
-                return *this;
+            template<class R, class... A>
+            static void addHandle( Fingerprint& fp , std::function<R(A...)> const& f ) {
+                typedef R (*fnPtr)( A... );
+                typedef point<N> (*diffPtr)( const point<N>& );
+                if( !f ) {
+                    fp.add( "NULL" );
+                    return;
+                }
+                fp.add( f.target_type().name() );
+                diffPtr anchor = id<N>;
+                if( const fnPtr* ptr = f.template target<fnPtr>() )
+                    fp.add( (int64_t)( reinterpret_cast<uintptr_t>( *ptr ) - reinterpret_cast<uintptr_t>( anchor ) ) );
             }
 
-            /** Performs the synthesis/inverse transform asynchronously.
+            // whether the windows are evaluated on the fly, see "setLazyWindows"
+            bool isLazy() const { return m_lazyWindows && !m_separable; }
+
+            /** Calls "f( win , rwin , index , lat , len )" for each run of a channel's window, as "WindowBank::forEachWindowRun"
+             *  does, with the rows of separable windows formed in "scratch". In lazy mode, the window is evaluated into
+             *  "scratch" first, unless "evaluated" is true, i.e. unless "scratch" holds the channel's window from a
+             *  previous call; the samples are complex then, i.e. "rwin" is NULL.
              *
-             *  @param  onFinish    a callback-function to be called, when the work is done
+             *  @param  j           the number of the channel
+             *  @param  L           the size of the channel's lattice in N dimensions
+             *  @param  scratch     buffers of the calling thread, receiving the dense window in lazy mode
+             *  @param  f           a callable
+             *  @param  evaluated   if true, "scratch" already holds the window; defaults to false
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @return             void
              */
-            SigmaTransform& asyncInverseTransform( std::function<void(SigmaTransform*)> onFinish ) {
-                 m_threads.insert( std::make_pair<std::string,std::thread>( "Inverse" , std::move( std::thread( [this,onFinish]() {
-                    //std::cout << "Starting 'Inverse' asynchronously."<<std::endl;
-                    // try to acquire mutex
-                    std::unique_lock<std::mutex> lk( m_mtx );
-                    //std::cout << "Acquired mutex in 'Inverse'"<<std::endl;
-                    // transform asynchronously
-                    this->synthesize( );
-                    // call callback
-                    onFinish( this );
-                } ) ) ) );
+            template<class F>
+            void forEachWindowRun( int const& j , std::array<int,N> const& L , WindowScratch<N,T>& scratch , F const& f , bool const& evaluated = false ) {
+                if( !isLazy() ) {
+                    m_windows->forEachWindowRun( j , L , f , 0 , (size_t) -1 , &scratch.row );
+                    return;
+                }
+                if( !evaluated )
+                    evaluateWindow( m_lazyWindow , m_lazyWindowBatch , m_steps[j] , scratch );
+                m_windows->forEachRun( m_windows->getBand( j ) , L , [&]( size_t const& , size_t const& index , size_t const& lat , int const& len ) {
+                    f( scratch.window.data() + index , (const T*) NULL , index , lat , len );
+                } );
+            }
+
+            /** Creates the windows in separable mode, see "setSeparable": for each axis k and each distinct coordinate
+             *  s of the steps along it, the factor window_k( action( sigma( x ) , s ) ) is evaluated on the Fourier axis.
+             *
+             *  @return             void
+             *
+             *  @throws             std::runtime_error, if the diffeomorphism, the action or the window are not separable
+             */
+            void makeSeparableWindows() {
+                // the diffeomorphism, the action and the window along a single axis
+                diffFunc<1>                 sigma   = axisForm( m_sigma );
+                actFunc<1>                  action  = axisForm( m_action );
+                std::array<winFunc<1>,N>    factors = m_windowFactors;
+                typedef std::complex<double> (*winPtr)( const point<N>& );
+                const winPtr* window = m_window.template target<winPtr>();
+                if( !m_window ) {
+                    point<N> width = warpedGaussianWidth();
+                    for( int k = 0 ; k < N ; ++k ) {
+                        double sd = width[k];
+                        factors[k] = [sd]( point<1> const& x ) { return gauss_stddev<1>( x , point<1>( sd ) ); };
+                    }
+                } else if( window && *window == &gauss<N> ) {
+                    factors.fill( winFunc<1>( gauss<1> ) );
+                }
+                if( !sigma || !action || !factors[0] ) {
+                    throw std::runtime_error("transform is not separable");
+                }
+                // distinct coordinates of the steps along each axis, and the factors of each channel
+                std::array<int,N>                   n = sizeArray(), numFactors;
+                std::array<std::vector<double>,N>   coords;
+                int                                 numSteps = m_steps.size(), total = 0;
+                for( int k = 0 ; k < N ; ++k ) {
+                    for( auto const& step : m_steps )
+                        coords[k].push_back( step[k] );
+                    std::sort( coords[k].begin() , coords[k].end() );
+                    coords[k].erase( std::unique( coords[k].begin() , coords[k].end() ) , coords[k].end() );
+                    numFactors[k] = coords[k].size();
+                    total        += numFactors[k];
+                }
+                m_windows->resetSeparable( n , numSteps , numFactors );
+                for( int j = 0 ; j < numSteps ; ++j ) {
+                    std::array<int,N> f;
+                    for( int k = 0 ; k < N ; ++k )
+                        f[k] = std::lower_bound( coords[k].begin() , coords[k].end() , m_steps[j][k] ) - coords[k].begin();
+                    m_windows->setFactors( j , f );
+                }
+                // the warped Fourier axes
+                std::array<std::vector<double>,N> axes;
+                for( int k = 0 ; k < N ; ++k ) {
+                    axes[k] = FourierAxis( m_fs[k] , n[k] );
+                    for( auto& x : axes[k] )
+                        x = sigma( point<1>( x ) )[0];
+                }
+                // evaluate the factors of each block in parallel
+                parallelFor( total , [&]( int const& first , int const& count ) {
+                    cxVec val;
+                    for( int t = first ; t < first + count ; ++t ) {
+                        // the axis and the number of the factor
+                        int k = 0, f = t;
+                        while( f >= numFactors[k] )
+                            f -= numFactors[k++];
+                        point<1> step( coords[k][f] );
+                        val.resize( n[k] );
+                        for( int i = 0 ; i < n[k] ; ++i )
+                            val[i] = cmpx( factors[k]( action( point<1>( axes[k][i] ) , step ) ) );
+                        m_windows->setFactor( k , f , val.data() , m_supportThreshold );
+                    }
+                } );
+                m_windows->finalize();
+            }
+
+            /** Checks, whether every window is a shift of one prototype on the Fourier grid, i.e. whether the
+             *  diffeomorphism is the identity and the action is the subtraction.
+             *
+             *  @return             true, if the transform is shift-structured
+             */
+            virtual bool isShiftStructured() const {
+                typedef point<N> (*diffPtr)( const point<N>& );
+                typedef point<N> (*actPtr)( const point<N>& , const point<N>& );
+                const diffPtr* sigma  = m_sigma.template target<diffPtr>();
+                const actPtr*  action = m_action.template target<actPtr>();
+                if( !sigma || !action || *sigma != &id<N> || *action != &minus<N> )
+                    return false;
+                // the grid needs two points per axis
+                for( int k = 0 ; k < N ; ++k )
+                    if( m_size[k] < 2 )
+                        return false;
+                return true;
+            }
+
+            /** Creates the windows of a shift-structured transform (see "isShiftStructured"), evaluating the prototype
+             *  only once for a unit of neighbouring channels, instead of once per channel.
+             *
+             *  Each step is split into a shift by whole points of the Fourier grid (see "FourierAxis") and a remaining
+             *  phase. Channels of the same phase are sorted by their shifts and split into units; the prototype is
+             *  evaluated on all grid points seen by the channels of a unit, and each window is copied from it. If the
+             *  support of a window, as determined by "WindowBank::setChannel", does not cross the border of the Fourier
+             *  domain, the window is not copied at all, but refers to the samples shared by the unit.
+             *
+             *  @param  window      function handle of the window
+             *  @param  windowBatch function handle of the window's batch form, may be NULL
+             *
+             *  @return             void
+             */
+            void makeShiftedWindows( winFunc<N> const& window , winBatchFunc<N> const& windowBatch ) {
+                // convenient vars: spacing and range of the signed indices of the Fourier grid
+                std::array<int,N> n = sizeArray(), kmin, kmax;
+                point<N>          d;
+                size_t            sigsize = m_size.prod();
+                int               numSteps = m_steps.size();
+                for( int k = 0 ; k < N ; ++k ) {
+                    d[k]    = m_fs[k] / ( n[k] - 1 );
+                    kmin[k] = n[k]/2 - n[k];
+                    kmax[k] = n[k]/2 - 1;
+                }
+                // split the steps into shifts by whole grid points and phases
+                std::vector<std::array<int,N>>          shift( numSteps );
+                std::vector<std::array<long long,N>>    phase( numSteps );
+                std::vector<point<N>>                   frac( numSteps );
+                for( int j = 0 ; j < numSteps ; ++j ) {
+                    for( int k = 0 ; k < N ; ++k ) {
+                        double u = m_steps[j][k] / d[k];
+                        if( m_stepOversampling > 0 ) {
+                            // rounded to a multiple of 1/m_stepOversampling
+                            long long r = llround( u * m_stepOversampling );
+                            shift[j][k] = (int) floor( (double) r / m_stepOversampling );
+                            phase[j][k] = r - (long long) shift[j][k] * m_stepOversampling;
+                            frac[j][k]  = phase[j][k] * d[k] / m_stepOversampling;
+                        } else {
+                            // phases closer than 1e-12 grid points are regarded as equal
+                            shift[j][k] = (int) llround( u );
+                            frac[j][k]  = m_steps[j][k] - shift[j][k] * d[k];
+                            phase[j][k] = llround( frac[j][k] / d[k] * 1E12 );
+                        }
+                    }
+                }
+                // sort by phase and shift, and split into units of neighbouring channels of the same phase
+                std::vector<int> order( numSteps );
+                for( int j = 0 ; j < numSteps ; ++j )
+                    order[j] = j;
+                std::sort( order.begin() , order.end() , [&]( int const& a , int const& b ) {
+                    return ( phase[a] != phase[b] ) ? phase[a] < phase[b] : shift[a] < shift[b];
+                } );
+                int perUnit = std::max( 1 , numSteps / ( 4 * m_numThreads ) );
+                std::vector<int> unitStart( 1 , 0 );
+                for( int i = 1 ; i < numSteps ; ++i ) {
+                    if( phase[order[i]] != phase[order[i-1]] || i - unitStart.back() == perUnit )
+                        unitStart.push_back( i );
+                }
+                int numUnits = unitStart.size();
+                unitStart.push_back( numSteps );
+                // reserve space for windows, one shared part per unit
+                m_windows->reset( n , numSteps , numUnits );
+                // create the windows of each block of units in parallel
+                parallelFor( numUnits , [&]( int const& firstUnit , int const& count ) {
+                    cxVec                               proto, win( sigsize );
+                    pointArray<N>                       xs;
+                    std::vector<std::complex<double>>   val;
+                    for( int u = firstUnit ; u < firstUnit + count ; ++u ) {
+                        // range of the shifts in the unit
+                        std::array<int,N> lo = shift[order[unitStart[u]]], hi = lo;
+                        for( int i = unitStart[u] ; i < unitStart[u+1] ; ++i ) {
+                            for( int k = 0 ; k < N ; ++k ) {
+                                lo[k] = std::min( lo[k] , shift[order[i]][k] );
+                                hi[k] = std::max( hi[k] , shift[order[i]][k] );
+                            }
+                        }
+                        // the prototype on the grid indices qmin,...,qmin+E-1 seen by the unit
+                        std::array<int,N> qmin, E, e;
+                        size_t numel = 1;
+                        for( int k = 0 ; k < N ; ++k ) {
+                            qmin[k] = kmin[k] - hi[k];
+                            E[k]    = n[k] + hi[k] - lo[k];
+                            numel  *= E[k];
+                        }
+                        point<N> const& f = frac[order[unitStart[u]]];
+                        proto.resize( numel );
+                        e.fill( 0 );
+                        for( size_t first = 0 ; first < numel ; first += batchSize() ) {
+                            // grid points of the next chunk
+                            xs.resize( std::min( batchSize() , numel - first ) );
+                            for( size_t i = 0 ; i < xs.size() ; ++i ) {
+                                for( int k = 0 ; k < N ; ++k )
+                                    xs[k][i] = ( qmin[k] + e[k] ) * d[k] - f[k];
+                                for( int k = 0 ; k < N && ++e[k] == E[k] ; ++k )
+                                    e[k] = 0;
+                            }
+                            windowOn( window , windowBatch , xs , val );
+                            std::copy( val.begin() , val.end() , proto.begin() + first );
+                        }
+                        // a single channel gains nothing from sharing
+                        std::array<int,N> blo, len;
+                        blo.fill( 0 ); len.fill( 0 );
+                        bool sharable = unitStart[u+1] - unitStart[u] > 1;
+                        // threshold and support of the prototype, as in "WindowBank::setChannel"
+                        double thr = 0;
+                        if( sharable && m_supportThreshold > 0 ) {
+                            for( auto const& p : proto )
+                                thr = std::max<double>( thr , std::norm( p ) );
+                            thr *= m_supportThreshold * m_supportThreshold;
+                        }
+                        std::array<std::vector<char>,N> used;
+                        for( int k = 0 ; k < N ; ++k )
+                            used[k].assign( E[k] , 0 );
+                        e.fill( 0 );
+                        for( size_t i = 0 ; i < numel && sharable ; ++i ) {
+                            // NaNs count as nonzero
+                            if( !( std::norm( proto[i] ) <= thr ) )
+                                for( int k = 0 ; k < N ; ++k )
+                                    used[k][e[k]] = 1;
+                            for( int k = 0 ; k < N && ++e[k] == E[k] ; ++k )
+                                e[k] = 0;
+                        }
+                        // the box may be shared, if no gap inside is as large as the gap outside of it
+                        for( int k = 0 ; k < N && sharable ; ++k ) {
+                            int first = std::find( used[k].begin() , used[k].end() , 1 ) - used[k].begin();
+                            int last  = used[k].rend() - std::find( used[k].rbegin() , used[k].rend() , 1 ) - 1;
+                            int hole  = 0;
+                            for( int i = first , run = 0 ; i <= last ; ++i ) {
+                                run  = used[k][i] ? 0 : run+1;
+                                hole = std::max( hole , run );
+                            }
+                            blo[k]   = first;
+                            len[k]   = last - first + 1;
+                            sharable = first < E[k] && n[k] - len[k] > hole;
+                        }
+                        bool anyShared = false;
+                        for( int i = unitStart[u] ; i < unitStart[u+1] ; ++i ) {
+                            int j = order[i];
+                            std::array<int,N> const& m = shift[j];
+                            // shared, if the box lies inside the Fourier domain
+                            bool inside = sharable;
+                            std::array<int,N> offset;
+                            for( int k = 0 ; k < N && inside ; ++k ) {
+                                int first = qmin[k] + blo[k] + m[k];
+                                inside    = first >= kmin[k] && first + len[k] - 1 <= kmax[k];
+                                offset[k] = first < 0 ? first + n[k] : first;
+                            }
+                            if( inside ) {
+                                m_windows->setChannel( j , offset , len , u );
+                                anyShared = true;
+                                continue;
+                            }
+                            // else copy the dense window from the prototype, row by row along the first axis
+                            std::array<int,N> ctr; ctr.fill( 0 );
+                            int h0 = n[0]/2, e0 = -m[0] - qmin[0];
+                            for( size_t row = 0 ; row < sigsize / n[0] ; ++row ) {
+                                size_t base = 0, stride = E[0];
+                                for( int k = 1 ; k < N ; ++k ) {
+                                    int q   = ( ctr[k] < n[k]/2 ? ctr[k] : ctr[k] - n[k] ) - m[k] - qmin[k];
+                                    base   += q * stride;
+                                    stride *= E[k];
+                                }
+                                const cmpx* src = proto.data() + base;
+                                cmpx*       dst = win.data() + row*n[0];
+                                std::copy( src + e0 , src + e0 + h0 , dst );
+                                std::copy( src + e0 + h0 - n[0] , src + e0 , dst + h0 );
+                                for( int k = 1 ; k < N && ++ctr[k] == n[k] ; ++k )
+                                    ctr[k] = 0;
+                            }
+                            m_windows->setChannel( j , win.data() , m_supportThreshold );
+                        }
+                        // the samples on the shared box
+                        if( anyShared ) {
+                            size_t boxel = 1;
+                            for( int k = 0 ; k < N ; ++k )
+                                boxel *= len[k];
+                            cxVec box( boxel );
+                            std::array<int,N> ctr; ctr.fill( 0 );
+                            for( size_t pos = 0 ; pos < boxel ; pos += len[0] ) {
+                                size_t base = 0, stride = 1;
+                                for( int k = 0 ; k < N ; ++k ) {
+                                    base   += ( blo[k] + ctr[k] ) * stride;
+                                    stride *= E[k];
+                                }
+                                std::copy( proto.begin() + base , proto.begin() + base + len[0] , box.begin() + pos );
+                                for( int k = 1 ; k < N && ++ctr[k] == len[k] ; ++k )
+                                    ctr[k] = 0;
+                            }
+                            m_windows->setShared( u , std::move( box ) );
+                        }
+                    }
+                } );
+                m_windows->finalize();
+            }
+
+            /** Queues the analysis of a signal as a job, and returns immediately.
+             *
+             *  The jobs of a SigmaTransform-object run one at a time, in the order they were queued, on the
+             *  workers of its job queue (see "setJobQueue"); the jobs of different objects run concurrently.
+             *  Hence, a synthesis queued after an analysis reconstructs the analyzed signal. The results are
+             *  valid after the job is done; meanwhile, the object must not be used synchronously.
+             *
+             *  @param  sig         the signal as a complex vector; pass it by std::move, to avoid copying it
+             *  @param  onFinish    a callback-function to be called by the job, when the work is done; defaults to NULL
+             *
+             *  @return             a future, which becomes ready when the job is done, and which rethrows
+             *                      the exceptions thrown by the job
+             */
+            std::future<void> analyzeAsync( cxVec sig , std::function<void(SigmaTransform*)> onFinish = NULL ) {
+                // the job owns the signal
+                std::shared_ptr<cxVec> in = std::make_shared<cxVec>( std::move( sig ) );
+                return submitJob( [this,in,onFinish]() {
+                    checkParameters();
+                    applyTransform( *in );
+                    if( onFinish ) onFinish( this );
+                } );
+            }
+
+            /** Queues the synthesis as a job, and returns immediately, see "analyzeAsync".
+             *
+             *  @param  onFinish    a callback-function to be called by the job, when the work is done; defaults to NULL
+             *
+             *  @return             a future, which becomes ready when the job is done
+             */
+            std::future<void> synthesizeAsync( std::function<void(SigmaTransform*)> onFinish = NULL ) {
+                return submitJob( [this,onFinish]() {
+                    applyInverseTransform( );
+                    if( onFinish ) onFinish( this );
+                } );
+            }
+
+            /** Queues the multiplier as a job, and returns immediately, see "analyzeAsync" and "multiplier".
+             *
+             *  @param  sig         the signal as a complex vector; pass it by std::move, to avoid copying it
+             *  @param  mask        the mask as a complex vector (of the same size as the coefficient-vector)
+             *  @param  onFinish    a callback-function to be called by the job, when the work is done; defaults to NULL
+             *
+             *  @return             a future, which becomes ready when the job is done
+             */
+            std::future<void> multiplierAsync( cxVec sig , cxVec mask , std::function<void(SigmaTransform*)> onFinish = NULL ) {
+                std::shared_ptr<cxVec> in = std::make_shared<cxVec>( std::move( sig ) ), msk = std::make_shared<cxVec>( std::move( mask ) );
+                return submitJob( [this,in,msk,onFinish]() {
+                    multiplier( *in , *msk );
+                    if( onFinish ) onFinish( this );
+                } );
+            }
+
+            /** Queues the multiplier as a job, and returns immediately, see "analyzeAsync" and "multiplier".
+             *
+             *  @param  sig         the signal as a complex vector; pass it by std::move, to avoid copying it
+             *  @param  maskFunc    a function handle for the masking function
+             *  @param  onFinish    a callback-function to be called by the job, when the work is done; defaults to NULL
+             *
+             *  @return             a future, which becomes ready when the job is done
+             */
+            std::future<void> multiplierAsync( cxVec sig , mskFunc<N> maskFunc , std::function<void(SigmaTransform*)> onFinish = NULL ) {
+                std::shared_ptr<cxVec> in = std::make_shared<cxVec>( std::move( sig ) );
+                return submitJob( [this,in,maskFunc,onFinish]() {
+                    multiplier( *in , maskFunc );
+                    if( onFinish ) onFinish( this );
+                } );
+            }
+
+            /** Performs the analysis/transform asynchronously, see "analyzeAsync".
+             *
+             *  @param  sig         signal as a complex vector
+             *  @param  onFinish    a callback-function to be called, when the work is done
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& asyncTransform( cxVec const& sig, std::function<void(SigmaTransform*)> onFinish ) {
+                analyzeAsync( sig , onFinish );
+                return *this;
+            }
+
+            /** Performs the synthesis/inverse transform asynchronously, see "synthesizeAsync".
+             *
+             *  @param  onFinish    a callback-function to be called, when the work is done
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& asyncInverseTransform( std::function<void(SigmaTransform*)> onFinish ) {
+                synthesizeAsync( onFinish );
                 return *this;
             }
 
-            /** Performs the multiplier asynchronously.
+            /** Performs the multiplier asynchronously, see "multiplierAsync".
              *
              *  @param  sig         signal as a complex vector
              *  @param  mask        complex mask vector of the same size as the coefficient-vector
@@ -420,65 +1341,34 @@ namespace SigmaTransform {
              *  @return             reference to the SigmaTransform-object
              */
             SigmaTransform& asyncMultiplier( cxVec const& sig, cxVec const& mask, std::function<void(SigmaTransform*)> onFinish ) {
-                 m_threads.insert( std::make_pair<std::string,std::thread>( "Multiplier" , std::move( std::thread( [this,sig,mask,onFinish]() {
-                    //std::cout << "Starting 'Multiplier' asynchronously."<<std::endl;
-                    // try to acquire mutex
-                    std::unique_lock<std::mutex> lk( m_mtx );
-                    //std::cout << "Acquired mutex in 'Multiplier'"<<std::endl;
-                    // transform asynchronously
-                    this->multiplier( sig,mask );
-                    // call callback
-                    onFinish( this );
-                } ) ) ) );
+                multiplierAsync( sig , mask , onFinish );
                 return *this;
             }
 
-            /** Performs the multiplier asynchronously.
+            /** Performs the multiplier asynchronously, see "multiplierAsync".
              *
              *  @param  sig         signal as a complex vector
              *  @param  maskFunc    a function handle for the masking function
              *  @param  onFinish    a callback-function to be called, when the work is done
              *
              *  @return             reference to the SigmaTransform-object
-             */ 
+             */
             SigmaTransform& asyncMultiplier( cxVec const& sig, mskFunc<N> maskFunc, std::function<void(SigmaTransform*)> onFinish ) {
-                 m_threads.insert( std::make_pair<std::string,std::thread>( "Multiplier" , std::move( std::thread( [this,sig,maskFunc,onFinish]() {
-                    //std::cout << "Starting 'Multiplier' asynchronously."<<std::endl;
-                    // try to acquire mutex
-                    std::unique_lock<std::mutex> lk( m_mtx );
-                    //std::cout << "Acquired mutex in 'Multiplier'"<<std::endl;
-                    // transform asynchronously
-                    this->multiplier( sig,maskFunc );
-                    // call callback
-                    onFinish( this );
-                } ) ) ) );
+                multiplierAsync( sig , maskFunc , onFinish );
                 return *this;
             }
 
-            /** Waits for the asynchronous-threads to join and finally deltes them.
+            /** Waits, until all jobs queued by the object are done, and rethrows the first exception thrown by
+             *  one of them since the previous call, e.g. by a job queued with a callback, whose future is not kept.
              *
              *  @return             reference to the SigmaTransform-object
+             *
+             *  @throws             the first exception of the jobs
              */
             SigmaTransform& join() {
-                // get threads to join
-                std::vector<std::string> toErase;
-                for( auto it = m_threads.begin(); it != m_threads.end() ; ++it ) {
-                    if( it->second.joinable() ) {
-                        //std::cout << "joining " << it->first << ".\n";
-                        it->second.join();
-                        toErase.push_back( it->first );
-                    }
-                }
-                // erase joined threads
-                for( auto const& name : toErase ) {
-                    for( auto it = m_threads.begin(); it != m_threads.end() ; ++it ) {
-                        if( name.compare( it->first) == 0 ) {
-                            //std::cout << "erasing " << it->first << ".\n";
-                            m_threads.erase( it );
-                            break;
-                        }
-                    }
-                }
+                std::exception_ptr error = m_jobs.wait();
+                if( error )
+                    std::rethrow_exception( error );
                 return *this;
             }
 
@@ -493,8 +1383,8 @@ namespace SigmaTransform {
                 // get space
                 cxVec out( in.size() );
                 // fft transform the signal
-                fftN( reinterpret_cast<fftw_complex*> (out.data()) ,
-                      reinterpret_cast<fftw_complex*>(const_cast<cmpx*> (in.data())) ,
+                fftN( reinterpret_cast<fftwComplex*> (out.data()) ,
+                      reinterpret_cast<fftwComplex*>(const_cast<cmpx*> (in.data())) ,
                       m_size , howmany , FFTW_FORWARD );
                 // return memory
                 return std::move( out );
@@ -509,11 +1399,56 @@ namespace SigmaTransform {
             */
             void fft_inplace( cxVec& inout , int const& howmany = 1 ) {
                 // ifft transform the signal
-                fftN( reinterpret_cast<fftw_complex*> (inout.data()) ,
-                      reinterpret_cast<fftw_complex*>(const_cast<cmpx*> (inout.data())) ,
+                fftN( reinterpret_cast<fftwComplex*> (inout.data()) ,
+                      reinterpret_cast<fftwComplex*>(const_cast<cmpx*> (inout.data())) ,
                       m_size , howmany , FFTW_FORWARD );
             }
 
+            /** Forward fft of a real signal, using a real-to-complex transform.
+            *
+            *   @param  in          real input vector of size "size"
+            *
+            *   @return             complex output vector holding the whole spectrum
+            */
+            cxVec fftReal( rVec const& in ) {
+                cxVec out( in.size() );
+                fftReal( in , out.data() );
+                // return memory
+                return std::move( out );
+            }
+
+            /** Forward fft of a real signal into a given buffer, see above.
+            *
+            *   @param  in          real input vector of size "size"
+            *   @param  out         pointer to a buffer of size "size", receiving the whole spectrum
+            *
+            *   @return             void
+            */
+            void fftReal( rVec const& in , cmpx* out ) {
+                // convenient vars
+                std::array<int,N> n = sizeArray();
+                size_t h0 = n[0]/2 + 1, rows = in.size() / n[0];
+                // the non-redundant half, along the first (fastest) axis, in the workspace
+                typename Workspace<N,T>::alignedVec& half = workspace().half;
+                half.resize( h0 * rows );
+                int sz[N];
+                for( int k = 0 ; k < N ; ++k )  sz[N-1-k] = n[k];
+                T*           pin  = const_cast<T*>( in.data() );
+                fftwComplex* pout = reinterpret_cast<fftwComplex*>( half.data() );
+                FFTW<T>::execute_dft_r2c( BasicFFTPlanCache<T>::instance().getR2C( N , sz , 1 , pin , pout , m_plannerFlags , m_numThreads ) ,
+                                          pin , pout );
+                // the other half by symmetry, F[-k] = conj( F[k] )
+                forEachMirroredRow( [&]( size_t const& row , size_t const& mirror ) {
+                    const cmpx* H  = half.data() + row*h0;
+                    const cmpx* Hm = half.data() + mirror*h0;
+                    cmpx*       F  = out + row*n[0];
+                    std::copy( H , H + h0 , F );
+                    for( int k = h0 ; k < n[0] ; ++k ) {
+                        F[k] = conj( Hm[n[0]-k] );
+                    }
+                } );
+            }
+
             /** Inverse fft - wrapper for fftN.
             *
             *   @param  in          complex input vector
@@ -525,8 +1460,8 @@ namespace SigmaTransform {
                 // get space
                 cxVec out( in.size() );
                 // ifft transform the signal
-                fftN( reinterpret_cast<fftw_complex*> (out.data()) ,
-                      reinterpret_cast<fftw_complex*>(const_cast<cmpx*> (in.data())) ,
+                fftN( reinterpret_cast<fftwComplex*> (out.data()) ,
+                      reinterpret_cast<fftwComplex*>(const_cast<cmpx*> (in.data())) ,
                       m_size , howmany , FFTW_BACKWARD );
                 // return memory
                 return std::move( out );
@@ -541,12 +1476,81 @@ namespace SigmaTransform {
             */
             void ifft_inplace( cxVec& inout , int const& howmany = 1 ) {
                 // ifft transform the signal
-                fftN( reinterpret_cast<fftw_complex*> (inout.data()) ,
-                      reinterpret_cast<fftw_complex*>(const_cast<cmpx*> (inout.data())) ,
+                fftN( reinterpret_cast<fftwComplex*> (inout.data()) ,
+                      reinterpret_cast<fftwComplex*>(const_cast<cmpx*> (inout.data())) ,
                       m_size , howmany , FFTW_BACKWARD );
             }
 
         protected:
+            /** Queues a job on the object's strand, see "analyzeAsync".
+             *
+             *  @param  job         the job
+             *
+             *  @return             a future, which becomes ready when the job is done
+             */
+            std::future<void> submitJob( std::function<void()> job ) {
+                if( !m_jobQueue )
+                    m_jobQueue = JobQueue::shared();
+                return m_jobs.submit( m_jobQueue , std::move( job ) );
+            }
+
+            /** Splits the range [0,num) into "m_numThreads" contiguous blocks and calls "job( first , count )"
+             *  for each non-empty block in parallel, either on the thread pool or on freshly spawned threads.
+             *
+             *  @param  num         the size of the range, e.g. the number of channels
+             *  @param  job         a callable, taking the first index and the length of a block
+             *
+             *  @return             void
+             */
+            template<class F>
+            void parallelFor( int const& num , F const& job ) {
+                int perThread = ceil( (double) num / m_numThreads );
+                auto block = [&]( int const& k ) {
+                    int first = k*perThread, count = std::min( perThread , num - first );
+                    if( count > 0 )
+                        job( first , count );
+                };
+                if( m_pool ) {
+                    m_pool->parallelFor( m_numThreads , block );
+                } else {
+                    // deallocates itself after leaving scope
+                    std::unique_ptr<std::thread[]> _threads( new std::thread[m_numThreads] );
+                    for( int k = 0 ; k < m_numThreads ; ++k )
+                        _threads[k] = std::thread( block , k );
+                    // wait for all threads to finish
+                    for( int k = 0 ; k < m_numThreads ; ++k )
+                        _threads[k].join();
+                }
+            }
+
+            /** Returns the signal size as an integer array.
+             *
+             *  @return             the size in N dimensions
+             */
+            std::array<int,N> sizeArray() const {
+                std::array<int,N> sz;
+                for( int k = 0 ; k < N ; ++k )
+                    sz[k] = (int) m_size[k];
+                return sz;
+            }
+
+            /** Checks, whether all parameters needed for a transform are set.
+             *
+             *  @return             void
+             *
+             *  @throws             std::runtime_error
+             */
+            void checkParameters() const {
+                if( !m_steps.size() ) {
+                    throw std::runtime_error("steps not set");
+                }
+                if( !m_fs.prod() ) {
+                    throw std::runtime_error("Fs not set");
+                }
+                if( !m_size.prod() ) {
+                    throw std::runtime_error("size not set");
+                }
+            }
 
             /** Generates a warped Fourier domain, from the spectral diffeomorphism and the sampling frequency.
              *
@@ -559,30 +1563,270 @@ namespace SigmaTransform {
                 for(auto& d : doms) {
                     d = FourierAxis( *itFs++ , *itSz++ );
                 }
-                m_domain = meshgridN( doms );
+                m_domain = std::make_shared<pointArray<N>>( meshgridArray( doms , m_pool.get() ) );
                 // ...and warp the domain
-                std::for_each(m_domain.begin(),m_domain.end(),[&](point<N>&x){x=m_sigma(x);});
+                warpDomain( *m_domain );
+            }
+
+            /** Applies the spectral diffeomorphism to each point of a domain, in place.
+             *
+             *  @param  dom         the points of the domain, one array per axis
+             *
+             *  @return             void
+             */
+            virtual void warpDomain( pointArray<N>& dom ) {
+                // blocks of points in parallel
+                parallelFor( dom.size() , [this,&dom]( int const& first , int const& count ) {
+                    // no batch form: point by point, in place
+                    if( !m_sigmaBatch ) {
+                        for( size_t i = first ; i < (size_t) ( first + count ) ; ++i )
+                            dom.set( i , m_sigma( dom.get( i ) ) );
+                        return;
+                    }
+                    // else in chunks, copied per axis
+                    pointArray<N> x;
+                    for( size_t c = first ; c < (size_t) ( first + count ) ; c += batchSize() ) {
+                        x.load( dom , c , std::min( batchSize() , first + count - c ) );
+                        m_sigmaBatch( x );
+                        for( int k = 0 ; k < N ; ++k )
+                            std::copy( x[k] , x[k] + x.size() , dom[k] + c );
+                    }
+                } );
+            }
+
+            /** Applies the spectral diffeomorphism to a range of points, in place. If the batch form is set, the points
+             *  are warped in chunks of "batchSize()" points, else point by point.
+             *
+             *  @param  pts         pointer to the first point
+             *  @param  count       the number of points
+             *
+             *  @return             void
+             */
+            void warpPoints( point<N>* pts , size_t const& count ) const {
+                if( !m_sigmaBatch ) {
+                    for( size_t i = 0 ; i < count ; ++i )
+                        pts[i] = m_sigma( pts[i] );
+                    return;
+                }
+                pointArray<N> x;
+                for( size_t first = 0 ; first < count ; first += batchSize() ) {
+                    x.load( pts + first , std::min( batchSize() , count - first ) );
+                    m_sigmaBatch( x );
+                    x.store( pts + first );
+                }
+            }
+
+            /** Evaluates the window of a channel on the warped domain, i.e. window( action( x , step ) ) for each
+             *  point x of "m_domain". Called for different channels in parallel.
+             *
+             *  @param  window      function handle of the window
+             *  @param  windowBatch function handle of the window's batch form, may be NULL
+             *  @param  step        the channel's step in the warped Fourier domain
+             *  @param  buf         buffers of the calling thread; "buf.window" receives the window, resized to the size
+             *                      of the domain, and "buf.points", "buf.values" hold the chunks of points
+             *
+             *  @return             void
+             */
+            virtual void evaluateWindow( winFunc<N> const& window , winBatchFunc<N> const& windowBatch , point<N> const& step , WindowScratch<N,T>& buf ) {
+                buf.window.resize( m_domain->size() );
+                cmpx* win = buf.window.data();
+                // no batch forms: point by point
+                if( !m_actionBatch && !windowBatch ) {
+                    for( size_t i = 0 ; i < m_domain->size() ; ++i ) {
+                        *win++ = window( m_action( m_domain->get( i ) , step ) );
+                    }
+                    return;
+                }
+                // else in chunks of points
+                pointArray<N>&                      x   = buf.points;
+                std::vector<std::complex<double>>&  val = buf.values;
+                for( size_t first = 0 ; first < m_domain->size() ; first += batchSize() ) {
+                    x.load( *m_domain , first , std::min( batchSize() , m_domain->size() - first ) );
+                    if( m_actionBatch ) {
+                        m_actionBatch( x , step );
+                    } else {
+                        for( size_t i = 0 ; i < x.size() ; ++i )
+                            x.set( i , m_action( x.get( i ) , step ) );
+                    }
+                    windowOn( window , windowBatch , x , val );
+                    std::copy( val.begin() , val.end() , win + first );
+                }
+            }
+
+            /** Evaluates a window at each point of an array, by its batch form, if given.
+             *
+             *  @param  window      function handle of the window
+             *  @param  windowBatch function handle of the window's batch form, may be NULL
+             *  @param  x           the points
+             *  @param  val         receives the values, resized to the number of points
+             *
+             *  @return             void
+             */
+            static void windowOn( winFunc<N> const& window , winBatchFunc<N> const& windowBatch , pointArray<N> const& x ,
+                                  std::vector<std::complex<double>>& val ) {
+                val.resize( x.size() );
+                if( windowBatch ) {
+                    windowBatch( x , val.data() );
+                    return;
+                }
+                for( size_t i = 0 ; i < x.size() ; ++i )
+                    val[i] = window( x.get( i ) );
+            }
+
+            // number of points evaluated per call of a batch form
+            static size_t batchSize() { return 1024; }
+
+            /** Returns the batch forms of the built-in functions "id", "logabs", "logpos", "minus", "plus" and "gauss",
+             *  when given as function pointers, and NULL for other function handles.
+             *
+             *  @param  f           function handle of a diffeomorphism, an action or a window
+             *
+             *  @return             function handle of the batch form, or NULL
+             */
+            static diffBatchFunc<N> batchForm( diffFunc<N> const& f ) {
+                typedef point<N> (*ptr)( const point<N>& );
+                const ptr* p = f.template target<ptr>();
+                if( p && *p == &id<N> )         return batch::id<N>;
+                if( p && *p == &logabs<N> )     return batch::logabs<N>;
+                if( p && *p == &logpos<N> )     return batch::logpos<N>;
+                return NULL;
+            }
+
+            static actBatchFunc<N> batchForm( actFunc<N> const& f ) {
+                typedef point<N> (*ptr)( const point<N>& , const point<N>& );
+                const ptr* p = f.template target<ptr>();
+                if( p && *p == &minus<N> )      return batch::minus<N>;
+                if( p && *p == &plus<N> )       return batch::plus<N>;
+                return NULL;
+            }
+
+            static winBatchFunc<N> batchForm( winFunc<N> const& f ) {
+                typedef std::complex<double> (*ptr)( const point<N>& );
+                const ptr* p = f.template target<ptr>();
+                if( p && *p == &gauss<N> )      return batch::gauss<N>;
+                return NULL;
+            }
+
+            /** Returns the forms on a single axis of the built-in functions "id", "logabs", "logpos", "minus" and "plus",
+             *  which act on each axis separately, when given as function pointers, and NULL for other function handles.
+             *
+             *  @param  f           function handle of a diffeomorphism or an action
+             *
+             *  @return             function handle of the 1D form, or NULL
+             */
+            static diffFunc<1> axisForm( diffFunc<N> const& f ) {
+                typedef point<N> (*ptr)( const point<N>& );
+                const ptr* p = f.template target<ptr>();
+                if( p && *p == &id<N> )         return id<1>;
+                if( p && *p == &logabs<N> )     return logabs<1>;
+                if( p && *p == &logpos<N> )     return logpos<1>;
+                return NULL;
+            }
+
+            static actFunc<1> axisForm( actFunc<N> const& f ) {
+                typedef point<N> (*ptr)( const point<N>& , const point<N>& );
+                const ptr* p = f.template target<ptr>();
+                if( p && *p == &minus<N> )      return minus<1>;
+                if( p && *p == &plus<N> )       return plus<1>;
+                return NULL;
+            }
+
+            /** Multiplies the coefficients with a mask, given by a callable "maskFunc( x , step )", see "applyMask".
+             *
+             *  @param  maskFunc    a callable, taking spatial and warped Fourier domain parameters
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            template<class M>
+            SigmaTransform& applyMaskWith( M const& maskFunc ) {
+                checkCoefficients();
+                // mask the coefficients of each block of channels in parallel
+                Workspace<N,T>& ws = workspace();
+                int perThread = ceil( (double) m_steps.size() / m_numThreads );
+                parallelFor( m_steps.size() , [this,&maskFunc,&ws,perThread]( int const& firstStep , int const& numSteps ) {
+                    // spatial domain of the current lattice, shared by consecutive channels of the same size
+                    LatticeDomain<N>& dom = ws.domain[firstStep / perThread];
+                    for( int j = firstStep ; j < firstStep + numSteps ; ++j ) {
+                        // coefficients of windows without support are zero
+                        if( !m_windows->getBand( j ).numel() )
+                            continue;
+                        // get iterator
+                        auto coeff = m_coeff.begin() + m_coeffOffset[j];
+                        // run thru all points
+                        for( auto const& x : latticeDomain( dom , m_coeffLength[j] ) ) {
+                            *coeff++ *= maskFunc( x , m_steps[j] );
+                        }
+                    }
+                } );
+                // return reference
+                return *this;
             }
 
             /** Generates a Spatial domain, from the size and the sampling frequency
              *
              *  @return             reference to the SigmaTransform-object
              */
-            std::vector<point<N>> makeSpatialDomain() {
+            std::vector<point<N>> makeSpatialDomain() { return makeSpatialDomain( sizeArray() ); }
+
+            /** Generates a Spatial domain of "L" points per axis, evenly covering the signal's extent,
+             *  i.e. the lattice on which decimated coefficients are sampled.
+             *
+             *  @param  L           the number of points in N dimensions
+             *
+             *  @return             the points of the lattice
+             */
+            std::vector<point<N>> makeSpatialDomain( std::array<int,N> const& L ) {
+                return meshgridN( spatialAxes( L ) , m_pool.get() );
+            }
+
+            /** Returns the axes of the spatial domain of a lattice of "L" points per axis, see "makeSpatialDomain".
+             *
+             *  @param  L           the number of points in N dimensions
+             *
+             *  @return             the coordinates along each axis
+             */
+            std::array<std::vector<double>,N> spatialAxes( std::array<int,N> const& L ) const {
                 std::array<std::vector<double>,N> doms;
-                auto itFs = m_fs.begin(), itSz = m_size.begin();
-                for(auto& d : doms) {
-                    d = linspace( 0 , (*itSz-1) / *itFs , *itSz );
-                    itFs++; itSz++;
+                for( int k = 0 ; k < N ; ++k ) {
+                    doms[k] = linspace( 0 , (L[k]-1) / m_fs[k] * ( m_size[k] / L[k] ) , L[k] );
                 }
-                return std::move( meshgridN( doms ) );
+                return doms;
+            }
+
+            /** Returns the spatial domain of a lattice of "L" points per axis, see "makeSpatialDomain",
+             *  regenerating it only if "L" differs from the size of the domain held by "dom".
+             *
+             *  @param  dom         the domain of the previous lattice, updated if necessary
+             *  @param  L           the number of points in N dimensions
+             *
+             *  @return             the points of the lattice, as an implicit grid
+             */
+            Grid<N> const& latticeDomain( LatticeDomain<N>& dom , std::array<int,N> const& L ) {
+                if( dom.size != L ) {
+                    dom.size   = L;
+                    dom.points = Grid<N>( spatialAxes( L ) );
+                }
+                return dom.points;
             }
 
             /** Generates a warped Gaussian window of adequate size.
              *
-             *  @return             reference to the SigmaTransform-object
+             *  @param  windowBatch receives the function handle of the window's batch form
+             *
+             *  @return             function handle of the warped Gaussian window
              */
-            void makeWarpedGaussian() {
+            winFunc<N> makeWarpedGaussian( winBatchFunc<N>& windowBatch ) {
+                auto width = warpedGaussianWidth();
+
+                windowBatch = [width](const pointArray<N>&x,std::complex<double>*out){ batch::gauss_stddev( x , width , out ); };
+                return [width](const point<N>&x)->std::complex<double>{ return gauss_stddev( x , width ); };
+            }
+
+            /** Returns an adequate standard deviation of the warped Gaussian window, from the steps and the window width.
+             *
+             *  @return             the standard deviation in N dimensions
+             */
+            point<N> warpedGaussianWidth() {
                 // make adequate standard deviation
                 point<N> maxi,mini,num_steps{1};
                 maxi=mini=m_steps[0];
@@ -601,48 +1845,174 @@ namespace SigmaTransform {
                 if( m_winWidth==0.0 )
                     m_winWidth = point<N>(8.0);
 
-                auto width = (maxi-mini) / num_steps * m_winWidth;
+                return (maxi-mini) / num_steps * m_winWidth;
+            }
 
-                m_window = [&](const point<N>&x)->cmpx{ return gauss_stddev( x , width ); };
+            /** Determines the size of each channel's coefficients and their offsets in the coefficient-vector.
+             *
+             *  @return             void
+             */
+            void makeCoeffLayout() {
+                int numSteps = m_steps.size();
+                m_coeffLength.resize( numSteps );
+                m_coeffOffset.resize( numSteps + 1 );
+                size_t total = 0;
+                for( int j = 0 ; j < numSteps ; ++j ) {
+                    band<N> const& b = m_windows->getBand( j );
+                    size_t numel = 1;
+                    for( int k = 0 ; k < N ; ++k ) {
+                        int n = (int) m_size[k];
+                        // decimated: the support's length, or the lattice given by the hop, if larger
+                        if( m_decimated )
+                            n = std::max( b.length[k] , m_hop[k] > 0 ? (int) ceil( m_size[k] / m_hop[k] ) : 0 );
+                        m_coeffLength[j][k] = n;
+                        numel *= n;
+                    }
+                    m_coeffOffset[j] = total;
+                    total           += numel;
+                }
+                m_coeffOffset[numSteps] = total;
+            }
+
+            /** Transforms the coefficients of a single (decimated) channel, or of a block of "howmany" channels
+             *  of the same size, in place and single-threaded, such that it may be called for different
+             *  channels in parallel.
+             *
+             *  @param  data        pointer to the channel's coefficients
+             *  @param  L           the size of the channel's lattice in N dimensions
+             *  @param  DIR         direction of the transform
+             *  @param  howmany     number of consecutive channels, defaults to 1
+             *
+             *  @return             void
+             */
+            void fftChannel( cmpx* data , std::array<int,N> const& L , int const& DIR , int const& howmany = 1 ) {
+                // FFTW expects the slowest axis first
+                int sz[N];
+                for( int k = 0 ; k < N ; ++k ) {
+                    if( !L[k] )
+                        return;
+                    sz[N-1-k] = L[k];
+                }
+                fftwComplex* p = reinterpret_cast<fftwComplex*>( data );
+                FFTW<T>::execute_dft( BasicFFTPlanCache<T>::instance().get( N , sz , howmany , p , p , DIR , m_plannerFlags , 1 ) , p , p );
             }
 
             /** Applies the actual transform in a multi-threaded manner.
+             *
+             *  In decimated mode, the windowed spectrum of each channel is wrapped onto the channel's lattice and
+             *  transformed separately, which yields the full coefficients sampled on that lattice, whenever its size
+             *  divides the signal size (and a modulated version of them otherwise).
              *
              *  @param  in          the signal as a complex vector
              *
              *  @return             reference to the SigmaTransform-object
              */
             SigmaTransform& applyTransform( const cxVec &in )  {
-                // convenient var
-                double sigsize  = m_size.prod();
-                // make windows
-                makeWindows( );
-                // fft transform the signal
-                cxVec Fsig = fft( in );
-                // copy the windows
-                m_coeff = m_windows;
-                // deallocates itself after leaving scope
-                std::unique_ptr<std::thread[]> _threads( new std::thread[m_numThreads] );
-                // start threads
-                int stepsPerThread = ceil( (double) (m_steps.size()) / m_numThreads );
-                for( int k = 0, stepsLeft = m_steps.size() ; k < m_numThreads ; ++k, stepsLeft -= stepsPerThread ) {
-                    _threads[k] = std::move( std::thread( [this,&Fsig,&stepsPerThread,stepsLeft,k]() {
-                        cxVec::iterator coeff = m_coeff.begin() + (int)( k*stepsPerThread*m_size.prod() );
-                        for( int i = 0 ; i < ((stepsLeft>stepsPerThread)?stepsPerThread:stepsLeft) ; ++i ) {
-                            for( auto const& val : Fsig ) {
-                                *coeff = conj(*coeff++) * val / ((double)Fsig.size());
-                            }
+                return applyTransformSpectrum( signalSpectrum( in ) );
+            }
+
+            /** Transforms a signal into the spectrum buffer of the workspace.
+             *
+             *  @param  in          the signal as a complex vector
+             *
+             *  @return             pointer to the spectrum
+             */
+            const cmpx* signalSpectrum( const cxVec &in ) {
+                typename Workspace<N,T>::alignedVec& spec = workspace().spectrum;
+                spec.resize( in.size() );
+                fftN( reinterpret_cast<fftwComplex*>( spec.data() ) ,
+                      reinterpret_cast<fftwComplex*>( const_cast<cmpx*>( in.data() ) ) ,
+                      m_size , 1 , FFTW_FORWARD );
+                return spec.data();
+            }
+
+            /** Returns the workspace, with buffers for each thread.
+             *
+             *  @return             reference to the workspace
+             */
+            Workspace<N,T>& workspace() { return m_workspace->reserveThreads( m_numThreads ); }
+
+            /** Applies the actual transform to the spectrum of a signal, see "applyTransform".
+             *
+             *  @param  Fsig        pointer to the spectrum of the signal
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            SigmaTransform& applyTransformSpectrum( const cmpx* Fsig )  {
+                transformSpectra( Fsig , 1 , m_coeff );
+                return *this;
+            }
+
+            /** Applies the actual transform to the spectra of "howmany" signals, stored one after another, and writes
+             *  the coefficients of each signal after another, each in the layout of "getCoeffOffsets".
+             *
+             *  The pairs of signals and channels are split among the threads signal by signal, such that the spectrum
+             *  of a signal stays in the cache, while it is multiplied with all windows; in lazy mode, they are split
+             *  channel by channel instead, such that each window is evaluated once for consecutive signals. For more
+             *  than one signal, the channels of a signal are transformed back as soon as the thread completed them (in
+             *  lazy mode, each channel right after its multiplication), while they are in the cache.
+             *
+             *  @param  Fsig        pointer to the spectra of the signals
+             *  @param  howmany     the number of signals
+             *  @param  coeff       receives the coefficients
+             *
+             *  @return             void
+             */
+            void transformSpectra( const cmpx* Fsig , int const& howmany , cxVec& coeff )  {
+                // convenient vars
+                size_t sigsize  = m_size.prod();
+                int    numSteps = m_steps.size();
+                // make windows, if not already done
+                prepare( );
+                // reserve space for the coefficients
+                makeCoeffLayout();
+                size_t total = m_coeffOffset.back();
+                coeff.resize( total * howmany );
+                // fused: number of channels transformed at once, such that they fit into the cache
+                bool fused    = m_fusedBytes && !m_decimated && howmany == 1;
+                bool batched  = !m_decimated && howmany > 1;
+                bool lazy     = isLazy();
+                int  perBlock = std::max( (size_t) 1 , m_fusedBytes / ( sigsize * sizeof(cmpx) ) );
+                // multiply each block of channels with the spectra on the windows' supports in parallel
+                ComplexKernels<T> const& K = ComplexKernels<T>::get();
+                Workspace<N,T>&          ws = workspace();
+                int perThread = ceil( (double) numSteps * howmany / m_numThreads );
+                parallelFor( numSteps * howmany , [&]( int const& firstItem , int const& numItems ) {
+                    // the thread's buffer for windows evaluated on the fly
+                    WindowScratch<N,T>& scratch = ws.scratch[firstItem / perThread];
+                    for( int q = firstItem ; q < firstItem + numItems ; ++q ) {
+                        // the channel and the signal; in lazy mode, the window of the previous item is the same, unless the channel changed
+                        int         j      = lazy ? q / howmany : q % numSteps;
+                        int         m      = lazy ? q % howmany : q / numSteps;
+                        const cmpx* F      = Fsig + m * sigsize;
+                        cmpx*       out    = coeff.data() + m * total + m_coeffOffset[j];
+                        std::fill( out , out + m_coeffOffset[j+1] - m_coeffOffset[j] , cmpx( 0 ) );
+                        forEachWindowRun( j , m_coeffLength[j] , scratch ,
+                                          [&]( const cmpx* window , const T* rwindow , size_t const& index , size_t const& lat , int const& len ) {
+                            if( rwindow )
+                                K.realMulScale( out + lat , rwindow , F + index , (T) 1 / sigsize , len );
+                            else
+                                K.conjMulScale( out + lat , window , F + index , (T) 1 / sigsize , len );
+                        } , lazy && m > 0 && q > firstItem );
+                        // decimated channels, and lazy channels of several signals, are transformed one at a time
+                        if( m_decimated || ( batched && lazy ) )
+                            fftChannel( out , m_coeffLength[j] , FFTW_BACKWARD );
+                        // several signals: transform the channels of a signal, which the thread completed, at once
+                        if( batched && !lazy && ( j == numSteps - 1 || q == firstItem + numItems - 1 ) ) {
+                            int count = std::min( j , q - firstItem ) + 1;
+                            fftChannel( out - (size_t) ( count - 1 ) * sigsize , sizeArray() , FFTW_BACKWARD , count );
                         }
-                    } ) );
-                }
-                // wait for all threads to finish
-                for( int k = 0 ; k < m_numThreads ; ++k ) {
-                    _threads[k].join();
-                }
+                        // fused: transform each completed block, while it is still in the cache
+                        int done = q - firstItem + 1;
+                        if( fused && ( done % perBlock == 0 || done == numItems ) ) {
+                            int count = ( done - 1 ) % perBlock + 1;
+                            fftChannel( out - (size_t) ( count - 1 ) * sigsize , sizeArray() , FFTW_BACKWARD , count );
+                        }
+                    }
+                } );
                 // transform back
-                ifft_inplace( m_coeff , m_steps.size() );
-                // return
-                return *this;
+                if( !m_decimated && !fused && !batched )
+                    ifft_inplace( coeff , numSteps );
             }
 
             /** Applies the actual inverse transform in a multi-threaded manner.
@@ -650,20 +2020,9 @@ namespace SigmaTransform {
              *  @return             reference to the SigmaTransform-object
              */
             SigmaTransform& applyInverseTransform()  {
-                // reserve vectorspace with zeros
-                m_reconstructed = cxVec( m_coeff.size() / m_steps.size() , 0 );
-
-                // fft transform the signal
-                cxVec temp = fft( m_coeff , m_steps.size() );
-
-                // act on signal
-                auto coeff = temp.begin(),
-                    window = m_windows.begin();
-                for(int k=0;k<m_steps.size();++k) {
-                    for( auto &val : m_reconstructed ) {
-                        val += (*coeff++) * (*window++);
-                    }
-                }
+                // sum up the channels in the Fourier domain
+                m_reconstructed.resize( m_size.prod() );
+                accumulateSpectrum( m_reconstructed.data() );
 
                 // transform back
                 ifft_inplace( m_reconstructed );
@@ -672,6 +2031,269 @@ namespace SigmaTransform {
                 return *this;
             }
 
+            /** Applies analysis, mask and synthesis to the spectrum of a signal, without storing the coefficients.
+             *
+             *  Each thread runs through its block of channels one at a time: the channel's coefficients are computed
+             *  as in "applyTransformSpectrum", masked, transformed forward and accumulated onto the thread's own
+             *  spectrum, as in "accumulateSpectrum". The spectra of the threads are summed up in a fixed order.
+             *  Hence, the memory needed is of the order of the signal size times the number of threads, instead of
+             *  the signal size times the number of channels.
+             *
+             *  @param  Fsig        pointer to the spectrum of the signal
+             *  @param  mask        a callable "mask( j , coeff , dom )", multiplying the coefficients "coeff" of the j-th
+             *                      channel with the mask in place; "dom" caches a spatial domain for "latticeDomain"
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            template<class M>
+            SigmaTransform& applyMultiplier( const cmpx* Fsig , M const& mask )  {
+                // convenient var
+                size_t sigsize  = m_size.prod();
+                // make windows, if not already done
+                prepare( );
+                makeCoeffLayout();
+                // one spectrum per block of channels, i.e. per thread, see "parallelFor"
+                ComplexKernels<T> const& K = ComplexKernels<T>::get();
+                Workspace<N,T>&          ws = workspace();
+                int perThread = ceil( (double) m_steps.size() / m_numThreads );
+                parallelFor( m_steps.size() , [&]( int const& firstStep , int const& numSteps ) {
+                    // the thread's buffers
+                    int                                     block   = firstStep / perThread;
+                    typename Workspace<N,T>::alignedVec&    spec    = ws.partial[block];
+                    typename Workspace<N,T>::alignedVec&    coeff   = ws.coeff[block];
+                    WindowScratch<N,T>&                     scratch = ws.scratch[block];
+                    LatticeDomain<N>&                       dom     = ws.domain[block];
+                    spec.assign( sigsize , 0 );
+                    for( int j = firstStep ; j < firstStep + numSteps ; ++j ) {
+                        // coefficients of windows without support are zero
+                        band<N> const& b = m_windows->getBand( j );
+                        if( !b.numel() )
+                            continue;
+                        size_t      len    = m_coeffOffset[j+1] - m_coeffOffset[j];
+                        // analyze the channel
+                        coeff.assign( len , 0 );
+                        forEachWindowRun( j , m_coeffLength[j] , scratch , [&]( const cmpx* window , const T* rwindow , size_t const& index , size_t const& lat , int const& run ) {
+                            if( rwindow )
+                                K.realMulScale( coeff.data() + lat , rwindow , Fsig + index , (T) 1 / sigsize , run );
+                            else
+                                K.conjMulScale( coeff.data() + lat , window , Fsig + index , (T) 1 / sigsize , run );
+                        } );
+                        fftChannel( coeff.data() , m_coeffLength[j] , FFTW_BACKWARD );
+                        // mask and transform back to the Fourier domain
+                        mask( j , coeff.data() , dom );
+                        fftChannel( coeff.data() , m_coeffLength[j] , FFTW_FORWARD );
+                        // accumulate onto the support of the window
+                        T scale = (T) sigsize / len;
+                        forEachWindowRun( j , m_coeffLength[j] , scratch , [&]( const cmpx* window , const T* rwindow , size_t const& index , size_t const& lat , int const& run ) {
+                            if( rwindow )
+                                K.realMulAcc( spec.data() + index , coeff.data() + lat , rwindow , scale , run );
+                            else
+                                K.mulAcc( spec.data() + index , coeff.data() + lat , window , scale , run );
+                        } , true );
+                    }
+                } );
+                // sum up the spectra of the threads
+                m_reconstructed.resize( sigsize );
+                sumSpectra( ws.partial , m_steps.size() , m_reconstructed.data() , sigsize );
+                // transform back
+                ifft_inplace( m_reconstructed );
+                // return
+                return *this;
+            }
+
+            /** Checks, whether the coefficients match the current windows and their layout, i.e. whether a signal
+             *  was analyzed since the windows were last invalidated by a setter.
+             *
+             *  @return             void
+             *
+             *  @throws             std::runtime_error
+             */
+            void checkCoefficients() const {
+                if( !m_windowsValid || m_coeffOffset.size() != m_steps.size() + 1 || m_coeff.size() != m_coeffOffset.back() ) {
+                    throw std::runtime_error("No coefficients for the current windows, call analyze first.");
+                }
+            }
+
+            /** Sums up the spectra of the coefficients, multiplied with the windows, in a multi-threaded manner.
+             *
+             *  @param  spec        pointer to a buffer of the signal's size, receiving the spectrum of the reconstruction
+             *
+             *  @return             void
+             *
+             *  @throws             std::runtime_error, see "checkCoefficients"
+             */
+            void accumulateSpectrum( cmpx* spec )  {
+                checkCoefficients();
+                accumulateSpectra( m_coeff.data() , 1 , spec );
+            }
+
+            /** Sums up the spectra of the coefficients of "howmany" signals, multiplied with the windows, in a
+             *  multi-threaded manner.
+             *
+             *  The indices of the signals are split among the threads and every index sums up the channels
+             *  in the same order, hence the result does not depend on the number of threads. With at least as many
+             *  signals as threads (and windows kept in the bank), the signals are split among the threads instead,
+             *  each transforming the coefficients of its signals one channel at a time, while they are in the cache.
+             *
+             *  @param  coeff       pointer to the coefficients of the signals, one after another, each in the layout
+             *                      of "getCoeffOffsets"
+             *  @param  howmany     the number of signals
+             *  @param  spec        pointer to a buffer of "howmany" times the signal's size, receiving the spectra of
+             *                      the reconstructions
+             *
+             *  @return             void
+             */
+            void accumulateSpectra( const cmpx* coeff , int const& howmany , cmpx* spec )  {
+                // convenient vars
+                size_t sigsize  = m_size.prod();
+                size_t total    = m_coeffOffset.back();
+                int    numSteps = m_steps.size();
+                Workspace<N,T>&                         ws   = workspace();
+                ComplexKernels<T> const&                K    = ComplexKernels<T>::get();
+
+                // many signals: each thread streams through the channels of its signals
+                if( howmany > 1 && howmany >= m_numThreads && !isLazy() ) {
+                    int perThread = ceil( (double) howmany / m_numThreads );
+                    parallelFor( howmany , [&]( int const& firstSignal , int const& numSignals ) {
+                        typename Workspace<N,T>::alignedVec&    c   = ws.coeff[firstSignal / perThread];
+                        typename WindowBank<N,T>::RowBuffer&    row = ws.scratch[firstSignal / perThread].row;
+                        for( int m = firstSignal ; m < firstSignal + numSignals ; ++m ) {
+                            cmpx* S = spec + m * sigsize;
+                            std::fill( S , S + sigsize , cmpx( 0 ) );
+                            for( int k = 0 ; k < numSteps ; ++k ) {
+                                // the spectrum of the channel's coefficients
+                                const cmpx* first = coeff + m * total + m_coeffOffset[k];
+                                c.assign( first , first + m_coeffOffset[k+1] - m_coeffOffset[k] );
+                                fftChannel( c.data() , m_coeffLength[k] , FFTW_FORWARD );
+                                // a lattice smaller than the signal scales the spectrum down
+                                T scale = (T) sigsize / c.size();
+                                m_windows->forEachWindowRun( k , m_coeffLength[k] ,
+                                                            [&]( const cmpx* window , const T* rwindow , size_t const& index , size_t const& lat , int const& len ) {
+                                    if( rwindow )
+                                        K.realMulAcc( S + index , c.data() + lat , rwindow , scale , len );
+                                    else
+                                        K.mulAcc( S + index , c.data() + lat , window , scale , len );
+                                } , 0 , (size_t) -1 , &row );
+                            }
+                        }
+                    } );
+                    return;
+                }
+
+                // fft transform the coefficients into the workspace, all at once or channel by channel
+                typename Workspace<N,T>::alignedVec&    temp = ws.coeffSpectrum;
+                temp.resize( total * howmany );
+                if( m_decimated ) {
+                    std::copy( coeff , coeff + total * howmany , temp.begin() );
+                    parallelFor( numSteps * howmany , [this,&temp,total,numSteps]( int const& firstItem , int const& numItems ) {
+                        for( int q = firstItem ; q < firstItem + numItems ; ++q ) {
+                            int j = q % numSteps;
+                            fftChannel( temp.data() + ( q / numSteps ) * total + m_coeffOffset[j] , m_coeffLength[j] , FFTW_FORWARD );
+                        }
+                    } );
+                } else {
+                    fftN( reinterpret_cast<fftwComplex*>( temp.data() ) , reinterpret_cast<fftwComplex*>( const_cast<cmpx*>( coeff ) ) ,
+                          m_size , numSteps * howmany , FFTW_FORWARD );
+                }
+
+                // lazy: each block of channels on spectra of its own, evaluating each window once for all signals
+                if( isLazy() ) {
+                    int perThread = ceil( (double) numSteps / m_numThreads );
+                    parallelFor( numSteps , [&]( int const& firstStep , int const& numSteps ) {
+                        typename Workspace<N,T>::alignedVec&    part    = ws.partial[firstStep / perThread];
+                        WindowScratch<N,T>&                     scratch = ws.scratch[firstStep / perThread];
+                        part.assign( sigsize * howmany , 0 );
+                        for( int k = firstStep ; k < firstStep + numSteps ; ++k ) {
+                            T scale = (T) sigsize / ( m_coeffOffset[k+1] - m_coeffOffset[k] );
+                            for( int m = 0 ; m < howmany ; ++m ) {
+                                const cmpx* c = temp.data() + m * total + m_coeffOffset[k];
+                                cmpx*       p = part.data() + m * sigsize;
+                                forEachWindowRun( k , m_coeffLength[k] , scratch , [&]( const cmpx* window , const T* , size_t const& index , size_t const& lat , int const& len ) {
+                                    K.mulAcc( p + index , c + lat , window , scale , len );
+                                } , m > 0 );
+                            }
+                        }
+                    } );
+                    sumSpectra( ws.partial , numSteps , spec , sigsize * howmany );
+                    return;
+                }
+                // act on each block of the signals in parallel, only on the windows' supports
+                int perThread = ceil( (double) sigsize * howmany / m_numThreads );
+                parallelFor( sigsize * howmany , [this,&temp,&ws,spec,&K,sigsize,total,perThread]( int const& firstIndex , int const& count ) {
+                    typename WindowBank<N,T>::RowBuffer& row = ws.scratch[firstIndex / perThread].row;
+                    // the part of the block inside each signal
+                    for( size_t m = firstIndex / sigsize ; m * sigsize < (size_t) firstIndex + count ; ++m ) {
+                        size_t      first = std::max( (size_t) firstIndex , m * sigsize ) - m * sigsize;
+                        size_t      last  = std::min( (size_t) firstIndex + count , ( m + 1 ) * sigsize ) - m * sigsize;
+                        cmpx*       S     = spec + m * sigsize;
+                        std::fill( S + first , S + last , cmpx( 0 ) );
+                        for( int k = 0 ; k < m_steps.size() ; ++k ) {
+                            const cmpx* c      = temp.data() + m * total + m_coeffOffset[k];
+                            // a lattice smaller than the signal scales the spectrum down
+                            T scale = (T) sigsize / ( m_coeffOffset[k+1] - m_coeffOffset[k] );
+                            m_windows->forEachWindowRun( k , m_coeffLength[k] ,
+                                                        [&]( const cmpx* window , const T* rwindow , size_t const& index , size_t const& lat , int const& len ) {
+                                // clip the run to this block
+                                size_t from = std::max( index , first ), to = std::min( index + len , last );
+                                if( from < to && rwindow )
+                                    K.realMulAcc( S + from , c + lat + from - index , rwindow + from - index , scale , to - from );
+                                else if( from < to )
+                                    K.mulAcc( S + from , c + lat + from - index , window + from - index , scale , to - from );
+                            } , first , last , &row );
+                        }
+                    }
+                } );
+            }
+
+            /** Sums up the spectra of the threads of a parallel loop over "num" items (see "parallelFor") in their
+             *  order, skipping the threads, which got no items.
+             *
+             *  @param  partial     the spectra of the threads, each of length "len"
+             *  @param  num         the number of items of the loop
+             *  @param  spec        pointer to a buffer of length "len", receiving the sum
+             *  @param  len         the length of the spectra, e.g. the signal's size
+             *
+             *  @return             void
+             */
+            void sumSpectra( std::vector<typename Workspace<N,T>::alignedVec> const& partial , int const& num , cmpx* spec , size_t const& len ) {
+                int    perThread = ceil( (double) num / m_numThreads );
+                int    used      = ( num + perThread - 1 ) / perThread;
+                // each block of the spectrum in parallel
+                parallelFor( len , [&partial,spec,used]( int const& first , int const& count ) {
+                    std::fill( spec + first , spec + first + count , cmpx( 0 ) );
+                    for( int p = 0 ; p < used ; ++p ) {
+                        for( size_t i = first ; i < first + count ; ++i ) {
+                            spec[i] += partial[p][i];
+                        }
+                    }
+                } );
+            }
+
+            /** Calls "f( row , mirror )" for each row of the signal along the first axis, where "mirror" is the row
+             *  at the negated indices of all other axes, i.e. the row holding the frequencies -k of row "row".
+             *
+             *  @param  f           a callable
+             *
+             *  @return             void
+             */
+            template<class F>
+            void forEachMirroredRow( F const& f ) const {
+                std::array<int,N> n = sizeArray(), ctr;
+                ctr.fill( 0 );
+                size_t rows = m_size.prod() / n[0];
+                for( size_t row = 0 ; row < rows ; ++row ) {
+                    size_t mirror = 0, stride = 1;
+                    for( int k = 1 ; k < N ; ++k ) {
+                        mirror += ( ( n[k] - ctr[k] ) % n[k] ) * stride;
+                        stride *= n[k];
+                    }
+                    f( row , mirror );
+                    // next row
+                    for( int k = 1 ; k < N && ++ctr[k] == n[k] ; ++k )
+                        ctr[k] = 0;
+                }
+            }
+
             /** Wrapper for the N-dimensional Fast Fourier Transform from the FFTW Lib.
             *
             *   @param  out         pointer to buffer, where the complex and transformed data is to be placed
@@ -680,40 +2302,80 @@ namespace SigmaTransform {
             *   @param  howmany     number of signals of size "size", found in the buffer "in"
             *   @param  DIR         direction of the transform
             *
-            *   @return             reference to the SigmaTransform-object
+            *   @return             void
             */
-            void fftN( fftw_complex *out, fftw_complex *in, const point<N> &size, const int &howmany = 1, const int& DIR = FFTW_FORWARD ) {
+            void fftN( fftwComplex *out, fftwComplex *in, const point<N> &size, const int &howmany = 1, const int& DIR = FFTW_FORWARD ) {
+                // FFTW expects the slowest axis first, while the first axis runs fastest here
                 int sz[N];
-                for( int k = 0 ; k < N ; ++k )  sz[k] = (int) size[k];
-                // make, perform and destroy FFTW-plan
-                fftw_plan p = fftw_plan_many_dft( N , sz , howmany ,  in  , NULL , 1 , (int) size.prod() ,
-                                                                      out , NULL , 1 , (int) size.prod() ,
-                                                                      DIR , FFTW_ESTIMATE );
-                fftw_execute( p );
-                fftw_destroy_plan( p );
+                for( int k = 0 ; k < N ; ++k )  sz[N-1-k] = (int) size[k];
+                // get (cached) FFTW-plan and execute it on the given buffers
+                typename FFTW<T>::plan p = BasicFFTPlanCache<T>::instance().get( N , sz , howmany , in , out , DIR , m_plannerFlags , m_numThreads );
+                FFTW<T>::execute_dft( p , in , out );
             }
 
             // function handles for the transform
-            std::function<cmpx(point<N>const&)>                     m_window;
+            winFunc<N>                                              m_window;
             std::function<point<N>(point<N>const&)>                 m_sigma;
             std::function<point<N>(point<N>const&,point<N>const&)>  m_action;
 
-            // holds data
-            cxVec                                   m_windows;
+            // batch forms of the function handles, NULL if not known
+            diffBatchFunc<N>                                        m_sigmaBatch;
+            actBatchFunc<N>                                         m_actionBatch;
+            winBatchFunc<N>                                         m_windowBatch;
+
+            // the window and its batch form as evaluated in lazy mode, see "setLazyWindows"
+            winFunc<N>                                              m_lazyWindow;
+            winBatchFunc<N>                                         m_lazyWindowBatch;
+
+            // factors of a separable window along each axis, see "setWindowFactors"; NULL if not given
+            std::array<winFunc<1>,N>                                m_windowFactors;
+
+            // holds data; the window bank is read-only once generated, and may be shared with contexts, see the copy constructor
+            std::shared_ptr<WindowBank<N,T>>        m_windows;
             cxVec                                   m_coeff;
             cxVec                                   m_reconstructed;
+            rVec                                    m_reconstructedReal;
+
+            // coefficients and reconstructions of a batch of signals, see "analyzeBatch"
+            cxVec                                   m_batchCoeff;
+            cxVec                                   m_batchReconstructed;
+            int                                     m_batchSize;
 
             // holds information about data
             point<N>                                m_size;
             point<N>                                m_fs;
             std::vector<point<N>>                   m_steps;
-            std::vector<point<N>>                   m_domain;
+            std::shared_ptr<pointArray<N>>          m_domain;
             int                                     m_numThreads;
             point<N>                                m_winWidth;
+            double                                  m_supportThreshold;
+            bool                                    m_windowsValid;
+            unsigned                                m_plannerFlags;
+
+            // layout of the (possibly decimated) coefficients
+            bool                                    m_decimated;
+            point<N>                                m_hop;
+            std::vector<std::array<int,N>>          m_coeffLength;
+            std::vector<size_t>                     m_coeffOffset;
+            size_t                                  m_fusedBytes;
+            int                                     m_stepOversampling;
+            bool                                    m_separable;
+            bool                                    m_lazyWindows;
+
+            // cache file of the window bank and the tag of its fingerprint, see "setWindowCache"
+            std::string                             m_windowCache;
+            std::string                             m_windowCacheTag;
+
+            // worker threads for the parallel loops, and whether they were set by "setThreadPool"
+            std::shared_ptr<ThreadPool>             m_pool;
+            bool                                    m_customPool;
+
+            // scratch buffers, see "setWorkspace"
+            std::shared_ptr<Workspace<N,T>>         m_workspace;
 
-            // for asynchronous computations
-            std::map<std::string,std::thread>       m_threads;
-            std::mutex                              m_mtx;
+            // the queue running the asynchronous jobs, and the strand keeping them in order, see "analyzeAsync"
+            std::shared_ptr<JobQueue>               m_jobQueue;
+            JobStrand                               m_jobs;
 
     }; // class SigmaTransform
 
@@ -0,0 +1,125 @@
+#ifndef SIGMATRANSFORMT_H
+#define SIGMATRANSFORMT_H
+
+#include <memory>
+#include <type_traits>
+
+#include "SigmaTransformN.h"
+#include "SigmaTransform_functors.h"
+
+namespace SigmaTransform {
+
+    /** Class template for the N-dimensional SigmaTransform with statically dispatched function objects.
+    *
+    *   The spectral diffeomorphism "Sigma", the window "Window" and the action "Action" are given as types,
+    *   e.g. the functors of the namespace "functors" or lambdas, instead of std::function-handles. The loops
+    *   over the samples, i.e. warping the Fourier domain, evaluating the windows and masking the coefficients,
+    *   thus call them directly, such that they may be inlined and vectorized.
+    *
+    *   The object is a SigmaTransform<N,T> otherwise, and may be used through a reference to it; the handles
+    *   of the base class are set to (type-erased) copies of the function objects, e.g. for "setSteps".
+    *   Setting other handles by "setSigma", "setWindow" or "setAction" is not supported.
+    *
+    *   Example, using a lambda as the window:
+    *
+    *       auto win = []( point<1> const& x ) { return std::complex<double>( fabs( x[0] ) < 1 ); };
+    *       SigmaTransformT<1,functors::LogPos<1>,decltype(win)> T( functors::LogPos<1>() , win , Fs , size , steps );
+    */
+    template<size_t N, class Sigma, class Window, class Action = functors::Minus<N>, class T = double>
+    class SigmaTransformT : public SigmaTransform<N,T> {
+        using Base = SigmaTransform<N,T>;
+
+        public:
+            using typename Base::cmpx;
+
+            /** Constructor.
+             *
+             *  @param  sigma       the spectral diffeomorphism, a callable mapping point<N> to point<N>
+             *  @param  window      the window template function, a callable mapping point<N> to a complex number
+             *  @param  Fs          the sampling frequency in N dimensions
+             *  @param  size        the size of the signals that are to be transformed in N dimensions
+             *  @param  steps       vector containing the channels in the warped Fourier domain in N dimensions
+             *  @param  action      the "group action" performed in the warped Fourier domain, a callable mapping
+             *                      two points to a point, defaults to "Action()"
+             *  @param  numThreads  the number of threads used for parallel processing, defaults to 4
+             */
+            SigmaTransformT( Sigma const& sigma, Window const& window, const point<N> &Fs=point<N>(0), const point<N> &size=point<N>(0),
+                             const std::vector<point<N>> &steps=std::vector<point<N>>(0), Action const& action=Action() , int const& numThreads = 4 )
+            : Base( (diffFunc<N>) sigma , (winFunc<N>) window , Fs , size , steps , (actFunc<N>) action , numThreads ),
+              m_sigmaT( sigma ), m_windowT( window ), m_actionT( action ) { }
+
+            // the queued jobs use the function objects below, hence they are waited for before destroying them
+            ~SigmaTransformT() { Base::m_jobs.wait(); }
+
+            /** Multiplies the coefficients with a mask, given by a callable "maskFunc( x , step )", which
+             *  is called directly instead of through a std::function-handle.
+             *
+             *  @param  maskFunc    a callable, taking spatial and warped Fourier domain parameters
+             *
+             *  @return             reference to the SigmaTransform-object
+             */
+            template<class M>
+            Base& applyMask( M const& maskFunc ) { return Base::applyMaskWith( maskFunc ); }
+
+            // masking by a vector
+            Base& applyMask( const typename Base::cxVec &mask ) { return Base::applyMask( mask ); }
+
+            // the function objects
+            Sigma const&    getSigmaT()  const { return m_sigmaT; }
+            Window const&   getWindowT() const { return m_windowT; }
+            Action const&   getActionT() const { return m_actionT; }
+
+        protected:
+            // warps the domain with the inlined diffeomorphism
+            void warpDomain( pointArray<N>& dom ) override {
+                for( size_t i = 0 ; i < dom.size() ; ++i ) {
+                    dom.set( i , m_sigmaT( dom.get( i ) ) );
+                }
+            }
+
+            // evaluates the window of a channel with the inlined window and action; the handle "window" is a copy of "m_windowT"
+            void evaluateWindow( winFunc<N> const& , winBatchFunc<N> const& , point<N> const& step , WindowScratch<N,T>& buf ) override {
+                pointArray<N> const& dom = *this->m_domain;
+                buf.window.resize( dom.size() );
+                cmpx* win = buf.window.data();
+                for( size_t i = 0 ; i < dom.size() ; ++i ) {
+                    *win++ = m_windowT( m_actionT( dom.get( i ) , step ) );
+                }
+            }
+
+            // shifts of a prototype, if the diffeomorphism is the identity and the action the subtraction
+            bool isShiftStructured() const override {
+                if( !std::is_same<Sigma,functors::Identity<N>>::value || !std::is_same<Action,functors::Minus<N>>::value )
+                    return false;
+                for( int k = 0 ; k < N ; ++k )
+                    if( this->m_size[k] < 2 )
+                        return false;
+                return true;
+            }
+
+            Sigma       m_sigmaT;
+            Window      m_windowT;
+            Action      m_actionT;
+    };
+
+    /** Creates a SigmaTransformT, deducing the types of the function objects, e.g. of lambdas.
+     *
+     *  @param  sigma       the spectral diffeomorphism
+     *  @param  window      the window template function
+     *  @param  Fs          the sampling frequency in N dimensions
+     *  @param  size        the size of the signals that are to be transformed in N dimensions
+     *  @param  steps       vector containing the channels in the warped Fourier domain in N dimensions
+     *  @param  action      the "group action" performed in the warped Fourier domain
+     *
+     *  @return             unique pointer to the new object
+     */
+    template<size_t N, class T = double, class Sigma, class Window, class Action = functors::Minus<N>>
+    std::unique_ptr<SigmaTransformT<N,Sigma,Window,Action,T>> makeSigmaTransformT( Sigma const& sigma, Window const& window,
+                const point<N> &Fs, const point<N> &size, const std::vector<point<N>> &steps, Action const& action = Action() ) {
+        return std::unique_ptr<SigmaTransformT<N,Sigma,Window,Action,T>>(
+            new SigmaTransformT<N,Sigma,Window,Action,T>( sigma , window , Fs , size , steps , action ) );
+    }
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORMT_H
@@ -0,0 +1,798 @@
+#ifndef SIGMATRANSFORM_BANK_H
+#define SIGMATRANSFORM_BANK_H
+
+#include <vector>
+#include <array>
+#include <complex>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "SigmaTransform_util.h"
+#include "SigmaTransform_file.h"
+
+namespace SigmaTransform {
+
+    /** Support of a window in the (fft-shifted) Fourier domain.
+    *
+    *   The support is a box of "length[k]" indices along each axis k, starting at index "offset[k]"
+    *   and wrapping around the end of the axis. The samples inside the box are stored contiguously,
+    *   with the first axis running fastest, starting at position "data" of the window bank.
+    */
+    template<size_t N>
+    struct band {
+        std::array<int,N>   offset;
+        std::array<int,N>   length;
+        size_t              data;
+
+        // number of samples inside the box
+        size_t numel() const { size_t p = 1; for( auto const& l : length ) p *= l; return p; }
+    };
+
+    /** Class template for a bank of windows, storing only the samples on each window's support.
+    *
+    *   Windows are handed to the bank as dense vectors over the whole Fourier domain, whose first axis
+    *   runs fastest (as produced by meshgridN). Samples with a modulus not larger than "threshold" times
+    *   the window's maximum are regarded as zero; the bank then keeps the smallest (circular) box
+    *   containing all other samples. A window without any zero is stored densely, as a box covering the
+    *   whole domain. The samples are stored with the precision of the scalar type "T"; if all of them are real,
+    *   which holds for the windows of all built-in transforms, only their real parts are stored, see "isReal".
+    *
+    *   Windows, which are shifts of each other, may share their samples: a shared part is stored once,
+    *   and each channel referring to it only keeps the offset of its box.
+    *
+    *   Separable windows, i.e. products of 1D windows ("factors") along each axis, may be stored by their
+    *   factors only, see "resetSeparable". The samples of a window are then formed row by row, when the
+    *   window is accessed by "forEachWindowRun".
+    *
+    *   A finished bank may be written to a file by "save" and mapped from it by "map", in which case the samples
+    *   are read from the mapping directly, instead of being copied into memory.
+    */
+    template<size_t N, class T = double>
+    class WindowBank {
+        public:
+            // complex samples of the given precision
+            using cmpx  = std::complex<T>;
+            using cxVec = std::vector<cmpx>;
+
+            /** Struct for the samples of a row of a separable window, formed by "forEachWindowRun". Passing the same
+             *  buffer to consecutive calls avoids allocating it again.
+             */
+            struct RowBuffer {
+                cxVec               complex;
+                std::vector<T>      real;
+            };
+
+            WindowBank() : m_real( false ), m_separable( false ), m_mapped( NULL ), m_mappedNumel( 0 ) { m_size.fill( 0 ); }
+
+            /** Clears the bank and prepares it for a set of windows.
+             *
+             *  @param  size        the size of the Fourier domain in N dimensions
+             *  @param  numChannels the number of windows
+             *  @param  numShared   the number of shared parts, see "setShared"; defaults to 0
+             *
+             *  @return             void
+             */
+            void reset( std::array<int,N> const& size , int const& numChannels , int const& numShared = 0 ) {
+                m_size = size;
+                m_bands.assign( numChannels , band<N>() );
+                m_parts.assign( numChannels , cxVec() );
+                m_shared.assign( numShared , cxVec() );
+                m_source.assign( numChannels , -1 );
+                m_data.clear();
+                m_realData.clear();
+                m_real        = false;
+                m_file.reset();
+                m_mapped      = NULL;
+                m_mappedNumel = 0;
+                m_separable   = false;
+                for( int k = 0 ; k < N ; ++k ) {
+                    m_factorBands[k].clear();
+                    m_factorParts[k].clear();
+                }
+                m_factors.clear();
+            }
+
+            /** Clears the bank and prepares it for a set of separable windows, which are stored by their factors.
+             *  Each window is the product of one factor per axis, see "setFactor" and "setFactors".
+             *
+             *  @param  size        the size of the Fourier domain in N dimensions
+             *  @param  numChannels the number of windows
+             *  @param  numFactors  the number of factors along each axis
+             *
+             *  @return             void
+             */
+            void resetSeparable( std::array<int,N> const& size , int const& numChannels , std::array<int,N> const& numFactors ) {
+                reset( size , numChannels );
+                m_separable = true;
+                for( int k = 0 ; k < N ; ++k ) {
+                    m_factorBands[k].assign( numFactors[k] , band<1>() );
+                    m_factorParts[k].assign( numFactors[k] , cxVec() );
+                }
+                m_factors.assign( numChannels , std::array<int,N>() );
+            }
+
+            /** Determines the support of a window and keeps the samples on it, until "finalize" is called.
+             *  Different channels may be set from different threads.
+             *
+             *  @param  channel     the number of the window
+             *  @param  window      pointer to the dense window
+             *  @param  threshold   samples with modulus <= threshold * (maximal modulus) are regarded as zero
+             *
+             *  @return             void
+             */
+            void setChannel( int const& channel , const cmpx* window , double const& threshold = 0 ) {
+                band<N>& b = m_bands[channel];
+                findSupport( b , window , threshold );
+                // copy the samples on the support
+                m_parts[channel].resize( b.numel() );
+                auto part = m_parts[channel].begin();
+                forEachRun( b , [&]( size_t const& pos , size_t const& index , int const& len ) {
+                    std::copy( window + index , window + index + len , part + pos );
+                } );
+            }
+
+            /** Determines the support of a window as "setChannel" does, but keeps no samples: the window has to be
+             *  supplied by the caller, whenever it is needed, e.g. evaluated on the fly. Different channels may be
+             *  set from different threads.
+             *
+             *  @param  channel     the number of the window
+             *  @param  window      pointer to the dense window
+             *  @param  threshold   samples with modulus <= threshold * (maximal modulus) are regarded as zero
+             *
+             *  @return             void
+             */
+            void setSupport( int const& channel , const cmpx* window , double const& threshold = 0 ) {
+                findSupport( m_bands[channel] , window , threshold );
+            }
+
+            /** Sets the samples of a shared part, i.e. of a box, which several channels refer to, see below.
+             *  Different parts may be set from different threads.
+             *
+             *  @param  part        the number of the shared part
+             *  @param  samples     the samples on the box, the first axis running fastest
+             *
+             *  @return             void
+             */
+            void setShared( int const& part , cxVec samples ) { m_shared[part] = std::move( samples ); }
+
+            /** Determines the support of a factor of separable windows (see "resetSeparable") and keeps the samples
+             *  on it. The support of a window is then the box spanned by the supports of its factors, which is the
+             *  support "setChannel" would determine for the product with the same threshold. Different factors may
+             *  be set from different threads.
+             *
+             *  @param  axis        the axis of the factor
+             *  @param  factor      the number of the factor along the axis
+             *  @param  samples     pointer to the factor on the whole axis, i.e. to "size()[axis]" samples
+             *  @param  threshold   samples with modulus <= threshold * (maximal modulus) are regarded as zero
+             *
+             *  @return             void
+             */
+            void setFactor( int const& axis , int const& factor , const cmpx* samples , double const& threshold = 0 ) {
+                int n = m_size[axis];
+                // threshold for the squared modulus
+                double thr = 0;
+                if( threshold > 0 ) {
+                    for( int i = 0 ; i < n ; ++i )
+                        thr = std::max<double>( thr , std::norm( samples[i] ) );
+                    thr *= threshold * threshold;
+                }
+                // NaNs count as nonzero
+                std::vector<char> used( n );
+                for( int i = 0 ; i < n ; ++i )
+                    used[i] = !( std::norm( samples[i] ) <= thr );
+                band<1>& b = m_factorBands[axis][factor];
+                circularSupport( used , b.offset[0] , b.length[0] );
+                // copy the samples on the support, wrapping around the end of the axis
+                cxVec& part = m_factorParts[axis][factor];
+                part.resize( b.length[0] );
+                for( int i = 0 ; i < b.length[0] ; ++i )
+                    part[i] = samples[( b.offset[0] + i ) % n];
+            }
+
+            /** Sets the factors of a separable window, see "resetSeparable". Different channels may be set from
+             *  different threads.
+             *
+             *  @param  channel     the number of the window
+             *  @param  factors     the number of the window's factor along each axis
+             *
+             *  @return             void
+             */
+            void setFactors( int const& channel , std::array<int,N> const& factors ) { m_factors[channel] = factors; }
+
+            /** Sets the support of a window explicitly, referring to the samples of a shared part instead of
+             *  keeping its own. Different channels may be set from different threads.
+             *
+             *  @param  channel     the number of the window
+             *  @param  offset      the first index of the box on each axis
+             *  @param  length      the length of the box on each axis, matching the size of the shared part
+             *  @param  part        the number of the shared part
+             *
+             *  @return             void
+             */
+            void setChannel( int const& channel , std::array<int,N> const& offset , std::array<int,N> const& length , int const& part ) {
+                m_bands[channel].offset = offset;
+                m_bands[channel].length = length;
+                m_source[channel]       = part;
+            }
+
+            /** Moves the windows set by "setChannel" and the shared parts into one contiguous buffer, which only keeps
+             *  the real parts, if all samples are real.
+             *
+             *  @return             void
+             */
+            void finalize() {
+                if( m_separable ) {
+                    finalizeSeparable();
+                    makeReal();
+                    return;
+                }
+                // own samples first, then the shared parts
+                size_t total = 0;
+                for( int j = 0 ; j < m_bands.size() ; ++j ) {
+                    if( m_source[j] >= 0 )
+                        continue;
+                    m_bands[j].data = total;
+                    total          += m_parts[j].size();
+                }
+                std::vector<size_t> sharedData( m_shared.size() );
+                for( int p = 0 ; p < m_shared.size() ; ++p ) {
+                    sharedData[p] = total;
+                    total        += m_shared[p].size();
+                }
+                m_data.resize( total );
+                for( int j = 0 ; j < m_bands.size() ; ++j ) {
+                    if( m_source[j] >= 0 ) {
+                        m_bands[j].data = sharedData[m_source[j]];
+                        continue;
+                    }
+                    std::copy( m_parts[j].begin() , m_parts[j].end() , m_data.begin() + m_bands[j].data );
+                    cxVec().swap( m_parts[j] );
+                }
+                for( int p = 0 ; p < m_shared.size() ; ++p ) {
+                    std::copy( m_shared[p].begin() , m_shared[p].end() , m_data.begin() + sharedData[p] );
+                    cxVec().swap( m_shared[p] );
+                }
+                makeReal();
+            }
+
+            /** Calls "f( pos , index , len )" for each contiguous run of the band along the first axis, where "pos"
+             *  is the position inside the box, "index" the linear index in the dense domain and "len" the length of the run.
+             *
+             *  @param  b           the band
+             *  @param  f           a callable
+             *
+             *  @return             void
+             */
+            template<class F>
+            void forEachRun( band<N> const& b , F const& f ) const {
+                size_t numel = b.numel();
+                if( !numel )
+                    return;
+                int n0 = m_size[0], o0 = b.offset[0], l0 = b.length[0], first = std::min( l0 , n0 - o0 );
+                std::array<int,N> ctr; ctr.fill( 0 );
+                for( size_t pos = 0 ; pos < numel ; pos += l0 ) {
+                    // linear index of the row's start along the other axes
+                    size_t base = 0, stride = n0;
+                    for( int k = 1 ; k < N ; ++k ) {
+                        base   += ( ( b.offset[k] + ctr[k] ) % m_size[k] ) * stride;
+                        stride *= m_size[k];
+                    }
+                    // at most two runs, if the band wraps around
+                    f( pos , base + o0 , first );
+                    if( l0 > first )
+                        f( pos + first , base , l0 - first );
+                    // next row
+                    for( int k = 1 ; k < N && ++ctr[k] == b.length[k] ; ++k )
+                        ctr[k] = 0;
+                }
+            }
+
+            /** Calls "f( pos , index , len )" for each contiguous run of a channel's band, see above.
+             *
+             *  @param  channel     the number of the window
+             *  @param  f           a callable
+             *
+             *  @return             void
+             */
+            template<class F>
+            void forEachRun( int const& channel , F const& f ) const { forEachRun( m_bands[channel] , f ); }
+
+            /** Calls "f( pos , index , lat , len )" for each run of the band, which is contiguous inside the box, in the
+             *  dense domain and on a lattice of size "L". The (unwrapped) frequency index offset[k]+i of the box is
+             *  mapped to the lattice index (offset[k]+i) mod L[k] on each axis k, which is one-to-one, as long as
+             *  L[k] >= length[k]. "lat" is the linear lattice index, with the first axis running fastest.
+             *
+             *  @param  b           the band
+             *  @param  L           the size of the lattice in N dimensions
+             *  @param  f           a callable
+             *
+             *  @return             void
+             */
+            template<class F>
+            void forEachRun( band<N> const& b , std::array<int,N> const& L , F const& f ) const {
+                size_t numel = b.numel();
+                if( !numel )
+                    return;
+                int n0 = m_size[0], o0 = b.offset[0], l0 = b.length[0];
+                std::array<int,N> ctr; ctr.fill( 0 );
+                for( size_t pos = 0 ; pos < numel ; pos += l0 ) {
+                    // linear indices of the row's start along the other axes
+                    size_t base = 0, stride = n0, lbase = 0, lstride = L[0];
+                    for( int k = 1 ; k < N ; ++k ) {
+                        base    += ( ( b.offset[k] + ctr[k] ) % m_size[k] ) * stride;
+                        lbase   += ( ( b.offset[k] + ctr[k] ) % L[k] ) * lstride;
+                        stride  *= m_size[k];
+                        lstride *= L[k];
+                    }
+                    // split the row, where it wraps around the domain or the lattice
+                    for( int i = 0 ; i < l0 ; ) {
+                        int index = ( o0 + i ) % n0, lat = ( o0 + i ) % L[0];
+                        int len   = std::min( l0 - i , std::min( n0 - index , L[0] - lat ) );
+                        f( pos + i , base + index , lbase + lat , len );
+                        i += len;
+                    }
+                    // next row
+                    for( int k = 1 ; k < N && ++ctr[k] == b.length[k] ; ++k )
+                        ctr[k] = 0;
+                }
+            }
+
+            /** Calls "f( win , rwin , index , lat , len )" for each run of a channel's band, as "forEachRun( band , L , f )"
+             *  does, where either "win" points to the "len" complex samples of the window on the run, or, if the bank is
+             *  real, "rwin" points to its real samples, the other pointer being NULL. The samples of separable windows are
+             *  formed for each row along the first axis, from the factors; the pointers then refer to a buffer, which is
+             *  only valid during the call. Rows, which lie completely outside of the range [from,to) of linear indices in
+             *  the dense domain, may be skipped.
+             *
+             *  @param  channel     the number of the window
+             *  @param  L           the size of the lattice in N dimensions
+             *  @param  f           a callable
+             *  @param  from        the first linear index of interest; defaults to 0
+             *  @param  to          one past the last linear index of interest; defaults to the end of the domain
+             *  @param  row         buffer for the rows of separable windows; defaults to NULL, i.e. a buffer of its own
+             *
+             *  @return             void
+             */
+            template<class F>
+            void forEachWindowRun( int const& channel , std::array<int,N> const& L , F const& f ,
+                                   size_t const& from = 0 , size_t const& to = (size_t) -1 , RowBuffer* row = NULL ) const {
+                band<N> const& b = m_bands[channel];
+                if( !m_separable ) {
+                    const cmpx* win  = m_real ? NULL : data( channel );
+                    const T*    rwin = m_real ? realData( channel ) : NULL;
+                    forEachRun( b , L , [&]( size_t const& pos , size_t const& index , size_t const& lat , int const& len ) {
+                        if( index < to && index + len > from )
+                            f( win ? win + pos : NULL , rwin ? rwin + pos : NULL , index , lat , len );
+                    } );
+                    return;
+                }
+                size_t numel = b.numel();
+                if( !numel )
+                    return;
+                int n0 = m_size[0], o0 = b.offset[0], l0 = b.length[0];
+                std::array<size_t,N> factor;
+                for( int k = 0 ; k < N ; ++k )
+                    factor[k] = m_factorBands[k][m_factors[channel][k]].data;
+                RowBuffer own;
+                if( !row )
+                    row = &own;
+                if( m_real )
+                    row->real.resize( std::max<size_t>( row->real.size() , l0 ) );
+                else
+                    row->complex.resize( std::max<size_t>( row->complex.size() , l0 ) );
+                std::array<int,N> ctr; ctr.fill( 0 );
+                for( size_t pos = 0 ; pos < numel ; pos += l0 ) {
+                    // linear indices of the row's start along the other axes, and the product of their factors
+                    size_t base = 0, stride = n0, lbase = 0, lstride = L[0];
+                    cmpx   c( 1 );
+                    for( int k = 1 ; k < N ; ++k ) {
+                        base    += ( ( b.offset[k] + ctr[k] ) % m_size[k] ) * stride;
+                        lbase   += ( ( b.offset[k] + ctr[k] ) % L[k] ) * lstride;
+                        stride  *= m_size[k];
+                        lstride *= L[k];
+                        c       *= m_real ? cmpx( realSamples()[factor[k] + ctr[k]] ) : samples()[factor[k] + ctr[k]];
+                    }
+                    if( base < to && base + n0 > from ) {
+                        // the row's samples: the factor of the first axis, times the others
+                        if( m_real ) {
+                            const T* w = realSamples() + factor[0];
+                            for( int i = 0 ; i < l0 ; ++i )
+                                row->real[i] = w[i] * c.real();
+                        } else {
+                            const cmpx* w = samples() + factor[0];
+                            for( int i = 0 ; i < l0 ; ++i )
+                                row->complex[i] = cmpx( w[i].real() * c.real() - w[i].imag() * c.imag() , w[i].real() * c.imag() + w[i].imag() * c.real() );
+                        }
+                        // split the row, where it wraps around the domain or the lattice
+                        for( int i = 0 ; i < l0 ; ) {
+                            int index = ( o0 + i ) % n0, lat = ( o0 + i ) % L[0];
+                            int len   = std::min( l0 - i , std::min( n0 - index , L[0] - lat ) );
+                            f( m_real ? NULL : row->complex.data() + i , m_real ? row->real.data() + i : NULL , base + index , lbase + lat , len );
+                            i += len;
+                        }
+                    }
+                    // next row
+                    for( int k = 1 ; k < N && ++ctr[k] == b.length[k] ; ++k )
+                        ctr[k] = 0;
+                }
+            }
+
+            /** Writes a window into a dense vector, filling the samples outside of its support with zeros.
+             *
+             *  @param  channel     the number of the window
+             *  @param  dense       pointer to a buffer of the size of the Fourier domain
+             *
+             *  @return             void
+             */
+            void expand( int const& channel , cmpx* dense ) const {
+                std::fill( dense , dense + denseSize() , cmpx( 0 ) );
+                forEachWindowRun( channel , m_size , [&]( const cmpx* win , const T* rwin , size_t const& index , size_t const& , int const& len ) {
+                    if( win )
+                        std::copy( win , win + len , dense + index );
+                    else
+                        std::copy( rwin , rwin + len , dense + index );
+                } );
+            }
+
+            /** Returns all windows as dense vectors, one after another.
+             *
+             *  @return             the dense windows
+             */
+            cxVec dense() const {
+                cxVec out( denseSize() * numChannels() );
+                for( int j = 0 ; j < numChannels() ; ++j )
+                    expand( j , out.data() + j*denseSize() );
+                return out;
+            }
+
+            /** Writes the bank to a binary file, which "map" accepts. The file starts with a header holding the
+             *  dimension N, the size of the scalar type, the size of the Fourier domain, the sampling rate, the steps
+             *  and a fingerprint of the parameters, which determined the windows; the layout of the bank (whether it is
+             *  real, the bands of the windows, and the factors in separable mode) follows, and finally the samples,
+             *  complex or real, starting at an offset aligned to 64 bytes. All numbers are stored in the byte order of
+             *  the machine. The file is written under a temporary name and renamed at the end, such that readers never
+             *  see a partially written file.
+             *
+             *  @param  filename    the name of the file
+             *  @param  fs          the sampling rate of the transform
+             *  @param  steps       the steps of the transform
+             *  @param  fingerprint a fingerprint of the parameters of the transform
+             *
+             *  @return             void
+             *
+             *  @throws             std::runtime_error, if the file cannot be written
+             */
+            void save( std::string const& filename , point<N> const& fs , std::vector<point<N>> const& steps , uint64_t const& fingerprint ) const {
+                // the header and the layout
+                std::string head = fileHeader( m_size , fs , steps , fingerprint );
+                append( head , (uint32_t) m_separable );
+                append( head , (uint32_t) m_real );
+                append( head , (uint64_t) m_bands.size() );
+                for( auto const& b : m_bands )
+                    append( head , b );
+                if( m_separable ) {
+                    for( int k = 0 ; k < N ; ++k ) {
+                        append( head , (uint64_t) m_factorBands[k].size() );
+                        for( auto const& b : m_factorBands[k] )
+                            append( head , b );
+                    }
+                    for( auto const& f : m_factors )
+                        append( head , f );
+                }
+                // the samples, aligned to 64 bytes
+                uint64_t num    = numel();
+                uint64_t offset = ( head.size() + 2*sizeof(uint64_t) + 63 ) / 64 * 64;
+                append( head , num );
+                append( head , offset );
+                head.resize( offset , 0 );
+                std::string tmp = filename + ".tmp";
+                {
+                    std::ofstream out( tmp.c_str() , std::ios::binary | std::ios::trunc );
+                    if( !out.is_open() )
+                        throw std::runtime_error( "Error opening File." );
+                    out.write( head.data() , head.size() );
+                    out.write( m_real ? (const char*) realSamples() : (const char*) samples() , num * sampleSize() );
+                    if( !out.good() )
+                        throw std::runtime_error( "Error writing File." );
+                }
+                #ifdef _WIN32
+                std::remove( filename.c_str() );
+                #endif
+                if( std::rename( tmp.c_str() , filename.c_str() ) != 0 )
+                    throw std::runtime_error( "Error writing File." );
+            }
+
+            /** Maps a bank from a file written by "save", if its header matches the given parameters. The samples are
+             *  then read from the mapping, which is shared by copies of the bank and lives as long as the last of them;
+             *  pages of the file, which are never accessed, are never read. Otherwise, the bank is left unchanged.
+             *
+             *  @param  filename    the name of the file
+             *  @param  size        the size of the Fourier domain in N dimensions
+             *  @param  fs          the sampling rate of the transform
+             *  @param  steps       the steps of the transform
+             *  @param  fingerprint a fingerprint of the parameters of the transform
+             *
+             *  @return             true, if the file exists, is complete and matches the parameters
+             */
+            bool map( std::string const& filename , std::array<int,N> const& size , point<N> const& fs ,
+                      std::vector<point<N>> const& steps , uint64_t const& fingerprint ) {
+                std::shared_ptr<MappedFile> file;
+                try {
+                    file = std::make_shared<MappedFile>( filename );
+                } catch( std::runtime_error& ) {
+                    return false;
+                }
+                // the header has to match byte by byte
+                std::string expected = fileHeader( size , fs , steps , fingerprint );
+                const char* pos = file->data(), *end = pos + file->size();
+                if( file->size() < expected.size() || memcmp( pos , expected.data() , expected.size() ) != 0 )
+                    return false;
+                pos += expected.size();
+                // the layout
+                WindowBank<N,T>     bank;
+                uint32_t            separable, real;
+                uint64_t            numChannels, numFactors, num, offset;
+                bank.m_size = size;
+                if( !read( pos , end , separable ) || !read( pos , end , real ) || !read( pos , end , numChannels ) || numChannels != steps.size() )
+                    return false;
+                bank.m_separable = separable != 0;
+                bank.m_real      = real != 0;
+                bank.m_bands.resize( numChannels );
+                for( auto& b : bank.m_bands )
+                    if( !read( pos , end , b ) )
+                        return false;
+                if( bank.m_separable ) {
+                    for( int k = 0 ; k < N ; ++k ) {
+                        if( !read( pos , end , numFactors ) || numFactors > (uint64_t)( end - pos ) )
+                            return false;
+                        bank.m_factorBands[k].resize( numFactors );
+                        for( auto& b : bank.m_factorBands[k] )
+                            if( !read( pos , end , b ) )
+                                return false;
+                    }
+                    bank.m_factors.resize( numChannels );
+                    for( auto& f : bank.m_factors )
+                        if( !read( pos , end , f ) )
+                            return false;
+                }
+                // the samples
+                if( !read( pos , end , num ) || !read( pos , end , offset ) || offset % 64 != 0
+                    || offset > file->size() || num > ( file->size() - offset ) / bank.sampleSize() )
+                    return false;
+                bank.m_file        = file;
+                bank.m_mapped      = file->data() + offset;
+                bank.m_mappedNumel = num;
+                if( !bank.consistent() )
+                    return false;
+                bank.m_parts.resize( numChannels );
+                bank.m_source.assign( numChannels , -1 );
+                *this = std::move( bank );
+                return true;
+            }
+
+            // number of windows, size of the domain, number of stored samples and their size in bytes
+            int                         numChannels()   const { return m_bands.size(); }
+            std::array<int,N> const&    size()          const { return m_size; }
+            size_t                      denseSize()     const { size_t p = 1; for( auto const& s : m_size ) p *= s; return p; }
+            size_t                      numel()         const { return m_file ? m_mappedNumel : m_real ? m_realData.size() : m_data.size(); }
+            size_t                      bytes()         const { return numel() * sampleSize(); }
+
+            // whether the windows are stored by their factors, see "resetSeparable"
+            bool                        isSeparable()   const { return m_separable; }
+
+            // whether all samples are real, and only their real parts are stored
+            bool                        isReal()        const { return m_real; }
+
+            // the support and the samples of a window, complex or real, see "isReal"; for separable windows, see
+            // "forEachWindowRun" instead
+            band<N> const&              getBand( int const& channel )   const { return m_bands[channel]; }
+            const cmpx*                 data( int const& channel )      const { return samples() + m_bands[channel].data; }
+            const T*                    realData( int const& channel )  const { return realSamples() + m_bands[channel].data; }
+
+            // whether the samples are read from a file mapping, see "map"
+            bool                        isMapped()      const { return (bool) m_file; }
+
+        private:
+            // all samples, complex or real, either owned or mapped, and the size of one of them
+            const cmpx* samples()       const { return m_file ? (const cmpx*) m_mapped : m_data.data(); }
+            const T*    realSamples()   const { return m_file ? (const T*) m_mapped : m_realData.data(); }
+            size_t      sampleSize()    const { return m_real ? sizeof(T) : sizeof(cmpx); }
+
+            /** Keeps only the real parts of the samples, if all of them are real.
+             *
+             *  @return             void
+             */
+            void makeReal() {
+                for( auto const& x : m_data )
+                    if( x.imag() != 0 )
+                        return;
+                m_realData.resize( m_data.size() );
+                for( size_t i = 0 ; i < m_data.size() ; ++i )
+                    m_realData[i] = m_data[i].real();
+                cxVec().swap( m_data );
+                m_real = true;
+            }
+
+            // identifies the files written by "save", see below
+            static std::string fileMagic() { return std::string( "SIGMAWB" , 8 ); }
+
+            // appends the bytes of a value to a buffer
+            template<class V>
+            static void append( std::string& buf , V const& value ) { buf.append( (const char*) &value , sizeof(V) ); }
+
+            // reads a value from a buffer, advancing "pos", unless it would pass "end"
+            template<class V>
+            static bool read( const char*& pos , const char* end , V& value ) {
+                if( (size_t)( end - pos ) < sizeof(V) )
+                    return false;
+                memcpy( &value , pos , sizeof(V) );
+                pos += sizeof(V);
+                return true;
+            }
+
+            /** Returns the header of a file written by "save", up to the layout of the bank.
+             *
+             *  @param  size        the size of the Fourier domain in N dimensions
+             *  @param  fs          the sampling rate of the transform
+             *  @param  steps       the steps of the transform
+             *  @param  fingerprint a fingerprint of the parameters of the transform
+             *
+             *  @return             the header
+             */
+            static std::string fileHeader( std::array<int,N> const& size , point<N> const& fs , std::vector<point<N>> const& steps , uint64_t const& fingerprint ) {
+                std::string head = fileMagic();
+                // version, byte order, dimension and precision
+                append( head , (uint32_t) 2 );
+                append( head , (uint32_t) 0x01020304 );
+                append( head , (uint32_t) N );
+                append( head , (uint32_t) sizeof(T) );
+                append( head , fingerprint );
+                append( head , size );
+                append( head , fs );
+                append( head , (uint64_t) steps.size() );
+                head.append( (const char*) steps.data() , steps.size() * sizeof(point<N>) );
+                return head;
+            }
+
+            /** Checks, whether all bands of a mapped bank lie inside the Fourier domain and the samples.
+             *
+             *  @return             true, if the bank is consistent
+             */
+            bool consistent() const {
+                for( int j = 0 ; j < m_bands.size() ; ++j ) {
+                    band<N> const& b = m_bands[j];
+                    for( int k = 0 ; k < N ; ++k ) {
+                        if( b.offset[k] < 0 || b.offset[k] >= m_size[k] || b.length[k] < 0 || b.length[k] > m_size[k] )
+                            return false;
+                        if( m_separable && ( m_factors[j][k] < 0 || m_factors[j][k] >= (int) m_factorBands[k].size() ) )
+                            return false;
+                    }
+                    if( !m_separable && b.data + b.numel() > m_mappedNumel )
+                        return false;
+                }
+                for( int k = 0 ; k < N && m_separable ; ++k )
+                    for( auto const& b : m_factorBands[k] )
+                        if( b.offset[0] < 0 || b.offset[0] >= m_size[k] || b.length[0] < 0 || b.length[0] > m_size[k] || b.data + b.length[0] > m_mappedNumel )
+                            return false;
+                return true;
+            }
+
+            /** Determines the support of a dense window, i.e. the smallest box containing all samples with a modulus
+             *  larger than "threshold" times the maximal modulus.
+             *
+             *  @param  b           the band, receiving the support
+             *  @param  window      pointer to the dense window
+             *  @param  threshold   samples with modulus <= threshold * (maximal modulus) are regarded as zero
+             *
+             *  @return             void
+             */
+            void findSupport( band<N>& b , const cmpx* window , double const& threshold ) const {
+                // threshold for the squared modulus
+                double thr = 0;
+                if( threshold > 0 ) {
+                    for( size_t i = 0 ; i < denseSize() ; ++i )
+                        thr = std::max<double>( thr , std::norm( window[i] ) );
+                    thr *= threshold * threshold;
+                }
+                // mark the used indices on each axis
+                std::array<std::vector<char>,N> used;
+                for( int k = 0 ; k < N ; ++k )
+                    used[k].assign( m_size[k] , 0 );
+                std::array<int,N> idx; idx.fill( 0 );
+                for( size_t i = 0 ; i < denseSize() ; ++i ) {
+                    // NaNs count as nonzero
+                    if( !( std::norm( window[i] ) <= thr ) )
+                        for( int k = 0 ; k < N ; ++k )
+                            used[k][idx[k]] = 1;
+                    for( int k = 0 ; k < N && ++idx[k] == m_size[k] ; ++k )
+                        idx[k] = 0;
+                }
+                // smallest circular interval on each axis
+                for( int k = 0 ; k < N ; ++k )
+                    circularSupport( used[k] , b.offset[k] , b.length[k] );
+            }
+
+            /** Determines the smallest circular interval containing all used indices of an axis, i.e. the
+             *  complement of the largest circular gap.
+             *
+             *  @param  used        flags of the used indices
+             *  @param  offset      receives the first index of the interval
+             *  @param  length      receives the length of the interval
+             *
+             *  @return             void
+             */
+            static void circularSupport( std::vector<char> const& used , int& offset , int& length ) {
+                int n = used.size(), gap = 0, gapEnd = 0, run = 0;
+                for( int i = 0 ; i < 2*n ; ++i ) {
+                    run = used[i%n] ? 0 : run+1;
+                    if( run > gap ) {
+                        gap    = std::min( run , n );
+                        gapEnd = (i+1) % n;
+                    }
+                }
+                offset = gapEnd;
+                length = n - gap;
+            }
+
+            /** Moves the factors set by "setFactor" into one contiguous buffer and sets the bands of the windows.
+             *
+             *  @return             void
+             */
+            void finalizeSeparable() {
+                size_t total = 0;
+                for( int k = 0 ; k < N ; ++k ) {
+                    for( auto& b : m_factorBands[k] ) {
+                        b.data = total;
+                        total += b.length[0];
+                    }
+                }
+                m_data.resize( total );
+                for( int k = 0 ; k < N ; ++k ) {
+                    for( int f = 0 ; f < m_factorParts[k].size() ; ++f ) {
+                        std::copy( m_factorParts[k][f].begin() , m_factorParts[k][f].end() , m_data.begin() + m_factorBands[k][f].data );
+                        cxVec().swap( m_factorParts[k][f] );
+                    }
+                }
+                // the box of each window is spanned by the supports of its factors
+                for( int j = 0 ; j < m_bands.size() ; ++j ) {
+                    for( int k = 0 ; k < N ; ++k ) {
+                        band<1> const& b   = m_factorBands[k][m_factors[j][k]];
+                        m_bands[j].offset[k] = b.offset[0];
+                        m_bands[j].length[k] = b.length[0];
+                    }
+                    m_bands[j].data = 0;
+                }
+            }
+
+            std::array<int,N>           m_size;
+            std::vector<band<N>>        m_bands;
+            cxVec                       m_data;
+            std::vector<cxVec>          m_parts;
+            std::vector<cxVec>          m_shared;
+            std::vector<int>            m_source;
+
+            // real windows: only the real parts of the samples
+            bool                        m_real;
+            std::vector<T>              m_realData;
+
+            // separable windows: the bands and samples of the factors along each axis, and the factors of each window
+            bool                                    m_separable;
+            std::array<std::vector<band<1>>,N>      m_factorBands;
+            std::array<std::vector<cxVec>,N>        m_factorParts;
+            std::vector<std::array<int,N>>          m_factors;
+
+            // the mapped file, see "map", and the samples inside it
+            std::shared_ptr<MappedFile>             m_file;
+            const char*                             m_mapped;
+            size_t                                  m_mappedNumel;
+    };
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_BANK_H
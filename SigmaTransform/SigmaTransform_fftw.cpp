@@ -0,0 +1,202 @@
+
+#include <tuple>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "SigmaTransform_fftw.h"
+
+namespace SigmaTransform {
+
+    // lexicographic ordering of the plan keys
+    template<class T>
+    bool BasicFFTPlanCache<T>::Key::operator<( Key const& r ) const {
+        return std::tie(   kind,   rank,   n,   howmany,   dir,   inplace,   alignIn,   alignOut,   numThreads,   flags )
+             < std::tie( r.kind, r.rank, r.n, r.howmany, r.dir, r.inplace, r.alignIn, r.alignOut, r.numThreads, r.flags );
+    }
+
+    // the process-wide instance, constructed once by the first caller
+    template<class T>
+    BasicFFTPlanCache<T>& BasicFFTPlanCache<T>::instance() {
+        static BasicFFTPlanCache cache;
+        return cache;
+    }
+
+    // initializes FFTW's threads, before any plan is made
+    template<class T>
+    BasicFFTPlanCache<T>::BasicFFTPlanCache() : m_threads( FFTW<T>::init_threads() != 0 ), m_generation( 1 ) {
+        if( !m_threads )
+            std::cerr << "thread error\n";
+    }
+
+    // fills the common fields of a key
+    template<class T>
+    typename BasicFFTPlanCache<T>::Key BasicFFTPlanCache<T>::makeKey( Kind const& kind, int const& rank, const int* n, int const& howmany,
+                                                                      int const& dir, unsigned const& flags, int const& numThreads ) {
+        if( rank < 1 || rank > maxRank ) {
+            throw std::runtime_error("Rank of transform not supported by the plan cache.");
+        }
+        Key key;
+        key.n.fill( 0 );
+        for( int k = 0 ; k < rank ; ++k )
+            key.n[k] = n[k];
+        key.kind       = kind;
+        key.rank       = rank;
+        key.howmany    = howmany;
+        key.dir        = dir;
+        key.numThreads = numThreads;
+        key.flags      = flags;
+        return key;
+    }
+
+    // returns a cached plan, or makes a new one
+    template<class T> template<class P>
+    typename FFTW<T>::plan BasicFFTPlanCache<T>::find( Key const& key, void* in, void* out, size_t const& bytesIn, size_t const& bytesOut,
+                                                       P const& planner ) {
+        // the last plans found by the calling thread, looked up without the lock (nor allocations), unless the
+        // cache was cleared since
+        static thread_local std::pair<Key,typename FFTW<T>::plan>  found[numFound];
+        static thread_local int                                     next = 0;
+        static thread_local unsigned long                           generation = 0;
+        if( generation != m_generation.load() ) {
+            for( auto& f : found )
+                f.second = NULL;
+            generation = m_generation.load();
+        }
+        for( auto const& f : found ) {
+            if( f.second && !( f.first < key ) && !( key < f.first ) )
+                return f.second;
+        }
+        auto remember = [&]( typename FFTW<T>::plan const& p ) {
+            found[next] = std::make_pair( key , p );
+            next = ( next + 1 ) % numFound;
+            return p;
+        };
+        // the planner is not thread safe
+        std::lock_guard<std::mutex> lk( m_mtx );
+        auto it = m_plans.find( key );
+        if( it != m_plans.end() )
+            return remember( it->second );
+        // FFTW_ESTIMATE does not touch the buffers, every other rigor needs scratch buffers of the same alignment
+        char *pin = (char*) in, *pout = (char*) out;
+        char *scratchIn = NULL, *scratchOut = NULL;
+        if( key.flags != FFTW_ESTIMATE ) {
+            scratchIn = (char*) FFTW<T>::malloc( std::max( bytesIn , bytesOut ) + key.alignIn );
+            pin       = scratchIn + key.alignIn;
+            if( key.inplace ) {
+                pout = pin;
+            } else {
+                scratchOut = (char*) FFTW<T>::malloc( bytesOut + key.alignOut );
+                pout       = scratchOut + key.alignOut;
+            }
+        }
+        // make plan, with its own number of threads
+        if( m_threads )
+            FFTW<T>::plan_with_nthreads( key.numThreads );
+        typename FFTW<T>::plan p = planner( pin , pout );
+        FFTW<T>::free( scratchIn );
+        FFTW<T>::free( scratchOut );
+        if( !p ) {
+            throw std::runtime_error("FFTW could not create a plan.");
+        }
+        m_plans.insert( std::make_pair( key , p ) );
+        return remember( p );
+    }
+
+    // complex-to-complex plans
+    template<class T>
+    typename FFTW<T>::plan BasicFFTPlanCache<T>::get( int const& rank, const int* n, int const& howmany, typename FFTW<T>::complex* in,
+                                                      typename FFTW<T>::complex* out, int const& dir, unsigned const& flags,
+                                                      int const& numThreads ) {
+        typedef typename FFTW<T>::complex complex;
+        Key key = makeKey( C2C , rank , n , howmany , dir , flags , numThreads );
+        key.inplace  = ( in == out );
+        key.alignIn  = FFTW<T>::alignment_of( in );
+        key.alignOut = FFTW<T>::alignment_of( out );
+        int dist = 1;
+        for( int k = 0 ; k < rank ; ++k )
+            dist *= n[k];
+        size_t bytes = sizeof(complex) * (size_t) dist * howmany;
+        return find( key , in , out , bytes , bytes , [&]( void* pin , void* pout ) {
+            return FFTW<T>::plan_many_dft( rank , n , howmany , (complex*) pin , (complex*) pout , dist , dir , flags );
+        } );
+    }
+
+    // real-to-complex plans
+    template<class T>
+    typename FFTW<T>::plan BasicFFTPlanCache<T>::getR2C( int const& rank, const int* n, int const& howmany, T* in,
+                                                         typename FFTW<T>::complex* out, unsigned const& flags, int const& numThreads ) {
+        typedef typename FFTW<T>::complex complex;
+        Key key = makeKey( R2C , rank , n , howmany , FFTW_FORWARD , flags , numThreads );
+        key.inplace  = ( (void*) in == (void*) out );
+        key.alignIn  = FFTW<T>::alignment_of( in );
+        key.alignOut = FFTW<T>::alignment_of( out );
+        // the last axis of the spectrum holds only its non-redundant half
+        int rdist = 1, cdist;
+        for( int k = 0 ; k < rank ; ++k )
+            rdist *= n[k];
+        cdist = rdist / n[rank-1] * ( n[rank-1]/2 + 1 );
+        return find( key , in , out , sizeof(T) * (size_t) rdist * howmany , sizeof(complex) * (size_t) cdist * howmany , [&]( void* pin , void* pout ) {
+            return FFTW<T>::plan_many_dft_r2c( rank , n , howmany , (T*) pin , rdist , (complex*) pout , cdist , flags );
+        } );
+    }
+
+    // complex-to-real plans
+    template<class T>
+    typename FFTW<T>::plan BasicFFTPlanCache<T>::getC2R( int const& rank, const int* n, int const& howmany, typename FFTW<T>::complex* in,
+                                                         T* out, unsigned const& flags, int const& numThreads ) {
+        typedef typename FFTW<T>::complex complex;
+        Key key = makeKey( C2R , rank , n , howmany , FFTW_BACKWARD , flags , numThreads );
+        key.inplace  = ( (void*) in == (void*) out );
+        key.alignIn  = FFTW<T>::alignment_of( in );
+        key.alignOut = FFTW<T>::alignment_of( out );
+        int rdist = 1, cdist;
+        for( int k = 0 ; k < rank ; ++k )
+            rdist *= n[k];
+        cdist = rdist / n[rank-1] * ( n[rank-1]/2 + 1 );
+        return find( key , in , out , sizeof(complex) * (size_t) cdist * howmany , sizeof(T) * (size_t) rdist * howmany , [&]( void* pin , void* pout ) {
+            return FFTW<T>::plan_many_dft_c2r( rank , n , howmany , (complex*) pin , cdist , (T*) pout , rdist , flags );
+        } );
+    }
+
+    // imports wisdom from a file
+    template<class T>
+    bool BasicFFTPlanCache<T>::importWisdom( std::string const& filename ) {
+        std::lock_guard<std::mutex> lk( m_mtx );
+        return FFTW<T>::import_wisdom( filename.c_str() ) != 0;
+    }
+
+    // exports the accumulated wisdom to a file
+    template<class T>
+    bool BasicFFTPlanCache<T>::exportWisdom( std::string const& filename ) {
+        std::lock_guard<std::mutex> lk( m_mtx );
+        return FFTW<T>::export_wisdom( filename.c_str() ) != 0;
+    }
+
+    // destroys all cached plans
+    template<class T>
+    void BasicFFTPlanCache<T>::clear() {
+        std::lock_guard<std::mutex> lk( m_mtx );
+        for( auto& p : m_plans )
+            FFTW<T>::destroy_plan( p.second );
+        m_plans.clear();
+        ++m_generation;
+    }
+
+    // number of cached plans
+    template<class T>
+    size_t BasicFFTPlanCache<T>::size() {
+        std::lock_guard<std::mutex> lk( m_mtx );
+        return m_plans.size();
+    }
+
+    template<class T>
+    BasicFFTPlanCache<T>::~BasicFFTPlanCache() {
+        clear();
+    }
+
+    // precompiled caches for double and float
+    template class BasicFFTPlanCache<double>;
+    template class BasicFFTPlanCache<float>;
+
+} // namespace SigmaTransform
@@ -0,0 +1,237 @@
+#ifndef SIGMATRANSFORM_FFTW_H
+#define SIGMATRANSFORM_FFTW_H
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <fftw3.h>
+
+namespace SigmaTransform {
+
+    /** Traits mapping a scalar type to the matching FFTW interface,
+    *   i.e. to the fftw_*-functions for double and the fftwf_*-functions for float.
+    */
+    template<class T> struct FFTW;
+
+    template<> struct FFTW<double> {
+        typedef fftw_complex    complex;
+        typedef fftw_plan       plan;
+        static int      init_threads()                              { return fftw_init_threads(); }
+        static void     plan_with_nthreads( int n )                 { fftw_plan_with_nthreads( n ); }
+        static plan     plan_many_dft( int rank, const int* n, int howmany, complex* in, complex* out, int dist, int dir, unsigned flags ) {
+            return fftw_plan_many_dft( rank, n, howmany, in, NULL, 1, dist, out, NULL, 1, dist, dir, flags );
+        }
+        static plan     plan_many_dft_r2c( int rank, const int* n, int howmany, double* in, int idist, complex* out, int odist, unsigned flags ) {
+            return fftw_plan_many_dft_r2c( rank, n, howmany, in, NULL, 1, idist, out, NULL, 1, odist, flags );
+        }
+        static plan     plan_many_dft_c2r( int rank, const int* n, int howmany, complex* in, int idist, double* out, int odist, unsigned flags ) {
+            return fftw_plan_many_dft_c2r( rank, n, howmany, in, NULL, 1, idist, out, NULL, 1, odist, flags );
+        }
+        static void     execute_dft( plan p, complex* in, complex* out ) { fftw_execute_dft( p, in, out ); }
+        static void     execute_dft_r2c( plan p, double* in, complex* out ) { fftw_execute_dft_r2c( p, in, out ); }
+        static void     execute_dft_c2r( plan p, complex* in, double* out ) { fftw_execute_dft_c2r( p, in, out ); }
+        static void     destroy_plan( plan p )                      { fftw_destroy_plan( p ); }
+        static int      alignment_of( complex* p )                  { return fftw_alignment_of( reinterpret_cast<double*>( p ) ); }
+        static int      alignment_of( double* p )                { return fftw_alignment_of( p ); }
+        static void*    malloc( size_t n )                          { return fftw_malloc( n ); }
+        static void     free( void* p )                             { fftw_free( p ); }
+        static int      import_wisdom( const char* filename )       { return fftw_import_wisdom_from_filename( filename ); }
+        static int      export_wisdom( const char* filename )       { return fftw_export_wisdom_to_filename( filename ); }
+    };
+
+    template<> struct FFTW<float> {
+        typedef fftwf_complex   complex;
+        typedef fftwf_plan      plan;
+        static int      init_threads()                              { return fftwf_init_threads(); }
+        static void     plan_with_nthreads( int n )                 { fftwf_plan_with_nthreads( n ); }
+        static plan     plan_many_dft( int rank, const int* n, int howmany, complex* in, complex* out, int dist, int dir, unsigned flags ) {
+            return fftwf_plan_many_dft( rank, n, howmany, in, NULL, 1, dist, out, NULL, 1, dist, dir, flags );
+        }
+        static plan     plan_many_dft_r2c( int rank, const int* n, int howmany, float* in, int idist, complex* out, int odist, unsigned flags ) {
+            return fftwf_plan_many_dft_r2c( rank, n, howmany, in, NULL, 1, idist, out, NULL, 1, odist, flags );
+        }
+        static plan     plan_many_dft_c2r( int rank, const int* n, int howmany, complex* in, int idist, float* out, int odist, unsigned flags ) {
+            return fftwf_plan_many_dft_c2r( rank, n, howmany, in, NULL, 1, idist, out, NULL, 1, odist, flags );
+        }
+        static void     execute_dft( plan p, complex* in, complex* out ) { fftwf_execute_dft( p, in, out ); }
+        static void     execute_dft_r2c( plan p, float* in, complex* out ) { fftwf_execute_dft_r2c( p, in, out ); }
+        static void     execute_dft_c2r( plan p, complex* in, float* out ) { fftwf_execute_dft_c2r( p, in, out ); }
+        static void     destroy_plan( plan p )                      { fftwf_destroy_plan( p ); }
+        static int      alignment_of( complex* p )                  { return fftwf_alignment_of( reinterpret_cast<float*>( p ) ); }
+        static int      alignment_of( float* p )                 { return fftwf_alignment_of( p ); }
+        static void*    malloc( size_t n )                          { return fftwf_malloc( n ); }
+        static void     free( void* p )                             { fftwf_free( p ); }
+        static int      import_wisdom( const char* filename )       { return fftwf_import_wisdom_from_filename( filename ); }
+        static int      export_wisdom( const char* filename )       { return fftwf_export_wisdom_to_filename( filename ); }
+    };
+
+    /** Class holding a process-wide cache of FFTW plans.
+    *
+    *   Plans are created once for each combination of transform size, number of transforms,
+    *   direction, in-/out-of-place operation, buffer alignment, planner rigor and number of
+    *   threads, and are afterwards executed on arbitrary buffers of the same layout, using
+    *   FFTW's new-array execute interface. Plans, which are not created with FFTW_ESTIMATE,
+    *   are made on scratch buffers, so the data of the caller is never overwritten by the planner.
+    *
+    *   The accumulated wisdom may be saved to and loaded from a file, such that a restarted
+    *   application does not need to measure its plans again.
+    *
+    *   The cache is thread safe: FFTW's planner is not, hence all planner calls of a precision are
+    *   serialized by one process-wide lock, see "plannerLock", while the cached plans are looked up
+    *   without it. FFTW's threads are initialized once, by the first call to "instance", and each
+    *   plan is made with its own number of threads, hence transforms with different numbers of
+    *   threads may be used concurrently.
+    *
+    *   The cache is instantiated for double (FFTPlanCache) and float (FFTPlanCachef), each
+    *   holding plans and wisdom of the respective FFTW library.
+    */
+    template<class T>
+    class BasicFFTPlanCache {
+        public:
+            // maximal rank of the cached transforms
+            static const int maxRank = 8;
+
+            // number of plans each thread looks up without the lock
+            static const int numFound = 8;
+
+            /** Returns the process-wide plan cache.
+             *
+             *  @return             reference to the plan cache
+             */
+            static BasicFFTPlanCache& instance();
+
+            /** Returns a plan for a batch of "howmany" contiguous complex N-dimensional transforms,
+             *  which may be executed on any buffers with the same alignment as "in" and "out".
+             *
+             *  @param  rank        the dimension of the transforms
+             *  @param  n           array containing the "rank" sizes of the transforms
+             *  @param  howmany     number of transforms found in the buffers
+             *  @param  in          pointer to the input buffer
+             *  @param  out         pointer to the output buffer, may be equal to "in"
+             *  @param  dir         direction of the transform, FFTW_FORWARD or FFTW_BACKWARD
+             *  @param  flags       the planner rigor, e.g. FFTW_ESTIMATE, FFTW_MEASURE or FFTW_PATIENT
+             *  @param  numThreads  number of threads the plan uses
+             *
+             *  @return             the (cached) plan, owned by the cache
+             *
+             *  @throws             std::runtime_error
+             */
+            typename FFTW<T>::plan get( int const& rank, const int* n, int const& howmany, typename FFTW<T>::complex* in,
+                                        typename FFTW<T>::complex* out, int const& dir, unsigned const& flags = FFTW_ESTIMATE,
+                                        int const& numThreads = 1 );
+
+            /** Returns a plan for a batch of "howmany" contiguous real-to-complex N-dimensional transforms. Each output
+             *  holds the non-redundant half of the spectrum, i.e. n[rank-1]/2+1 entries along the last (fastest) axis.
+             *
+             *  @param  rank        the dimension of the transforms
+             *  @param  n           array containing the "rank" (real) sizes of the transforms
+             *  @param  howmany     number of transforms found in the buffers
+             *  @param  in          pointer to the real input buffer
+             *  @param  out         pointer to the complex output buffer
+             *  @param  flags       the planner rigor, e.g. FFTW_ESTIMATE, FFTW_MEASURE or FFTW_PATIENT
+             *  @param  numThreads  number of threads the plan uses
+             *
+             *  @return             the (cached) plan, owned by the cache
+             *
+             *  @throws             std::runtime_error
+             */
+            typename FFTW<T>::plan getR2C( int const& rank, const int* n, int const& howmany, T* in, typename FFTW<T>::complex* out,
+                                           unsigned const& flags = FFTW_ESTIMATE, int const& numThreads = 1 );
+
+            /** Returns a plan for a batch of "howmany" contiguous complex-to-real N-dimensional transforms, the
+             *  inverse of "getR2C". NOTE: executing the plan overwrites its input.
+             *
+             *  @param  rank        the dimension of the transforms
+             *  @param  n           array containing the "rank" (real) sizes of the transforms
+             *  @param  howmany     number of transforms found in the buffers
+             *  @param  in          pointer to the complex input buffer, holding the halves of the spectra
+             *  @param  out         pointer to the real output buffer
+             *  @param  flags       the planner rigor, e.g. FFTW_ESTIMATE, FFTW_MEASURE or FFTW_PATIENT
+             *  @param  numThreads  number of threads the plan uses
+             *
+             *  @return             the (cached) plan, owned by the cache
+             *
+             *  @throws             std::runtime_error
+             */
+            typename FFTW<T>::plan getC2R( int const& rank, const int* n, int const& howmany, typename FFTW<T>::complex* in, T* out,
+                                           unsigned const& flags = FFTW_ESTIMATE, int const& numThreads = 1 );
+
+            /** Imports wisdom from a file, which was created by "exportWisdom".
+             *
+             *  @param  filename    name of the wisdom file
+             *
+             *  @return             true on success
+             */
+            bool importWisdom( std::string const& filename );
+
+            /** Exports the accumulated wisdom of all plans made so far to a file.
+             *
+             *  @param  filename    name of the wisdom file
+             *
+             *  @return             true on success
+             */
+            bool exportWisdom( std::string const& filename );
+
+            /** Destroys all cached plans. Must not be called, while plans of the cache are executed.
+             *
+             *  @return             void
+             */
+            void clear();
+
+            /** Returns the lock serializing the calls to FFTW's planner. Code making FFTW plans (or handling
+             *  wisdom) of its own, while transforms are used in other threads, has to hold it meanwhile.
+             *
+             *  @return             reference to the planner lock
+             */
+            std::mutex& plannerLock() { return m_mtx; }
+
+            /** Returns the number of cached plans.
+             *
+             *  @return             number of cached plans
+             */
+            size_t size();
+
+            ~BasicFFTPlanCache();
+
+        private:
+            BasicFFTPlanCache();
+            BasicFFTPlanCache( BasicFFTPlanCache const& ) = delete;
+            BasicFFTPlanCache& operator=( BasicFFTPlanCache const& ) = delete;
+
+            // kinds of transforms
+            enum Kind { C2C, R2C, C2R };
+
+            // identifies a plan
+            struct Key {
+                std::array<int,maxRank> n;
+                int                     kind, rank, howmany, dir, inplace, alignIn, alignOut, numThreads;
+                unsigned                flags;
+                bool operator<( Key const& r ) const;
+            };
+
+            // fills the key's fields, which all kinds of transforms have in common
+            Key makeKey( Kind const& kind, int const& rank, const int* n, int const& howmany, int const& dir,
+                         unsigned const& flags, int const& numThreads );
+
+            // returns the cached plan for the key, or makes one with "planner( in , out )"
+            template<class P>
+            typename FFTW<T>::plan find( Key const& key, void* in, void* out, size_t const& bytesIn, size_t const& bytesOut, P const& planner );
+
+            std::map<Key,typename FFTW<T>::plan>    m_plans;
+            std::mutex                              m_mtx;
+
+            // whether FFTW's threads are available, and the number of calls to "clear", which invalidates
+            // the plans looked up by the threads
+            bool                                    m_threads;
+            std::atomic<unsigned long>              m_generation;
+    };
+
+    // the plan caches for double and float precision
+    typedef BasicFFTPlanCache<double>   FFTPlanCache;
+    typedef BasicFFTPlanCache<float>    FFTPlanCachef;
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_FFTW_H
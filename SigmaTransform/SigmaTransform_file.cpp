@@ -0,0 +1,73 @@
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "SigmaTransform_file.h"
+
+namespace SigmaTransform {
+
+    #ifdef _WIN32
+
+    MappedFile::MappedFile( std::string const& filename ) : m_addr( NULL ), m_size( 0 ), m_file( NULL ), m_map( NULL ) {
+        HANDLE file = CreateFileA( filename.c_str() , GENERIC_READ , FILE_SHARE_READ | FILE_SHARE_DELETE , NULL , OPEN_EXISTING , FILE_ATTRIBUTE_NORMAL , NULL );
+        if( file == INVALID_HANDLE_VALUE )
+            throw std::runtime_error( "Error opening File." );
+        LARGE_INTEGER size;
+        if( !GetFileSizeEx( file , &size ) || !size.QuadPart ) {
+            CloseHandle( file );
+            throw std::runtime_error( "Error mapping File." );
+        }
+        HANDLE map = CreateFileMappingA( file , NULL , PAGE_READONLY , 0 , 0 , NULL );
+        void*  addr = map ? MapViewOfFile( map , FILE_MAP_READ , 0 , 0 , 0 ) : NULL;
+        if( !addr ) {
+            if( map )
+                CloseHandle( map );
+            CloseHandle( file );
+            throw std::runtime_error( "Error mapping File." );
+        }
+        m_addr = addr;
+        m_size = (size_t) size.QuadPart;
+        m_file = file;
+        m_map  = map;
+    }
+
+    MappedFile::~MappedFile() {
+        UnmapViewOfFile( m_addr );
+        CloseHandle( (HANDLE) m_map );
+        CloseHandle( (HANDLE) m_file );
+    }
+
+    #else
+
+    MappedFile::MappedFile( std::string const& filename ) : m_addr( NULL ), m_size( 0 ) {
+        int fd = open( filename.c_str() , O_RDONLY );
+        if( fd < 0 )
+            throw std::runtime_error( "Error opening File." );
+        struct stat st;
+        if( fstat( fd , &st ) != 0 || st.st_size <= 0 ) {
+            close( fd );
+            throw std::runtime_error( "Error mapping File." );
+        }
+        // the mapping keeps the file open by itself
+        void* addr = mmap( NULL , (size_t) st.st_size , PROT_READ , MAP_SHARED , fd , 0 );
+        close( fd );
+        if( addr == MAP_FAILED )
+            throw std::runtime_error( "Error mapping File." );
+        m_addr = addr;
+        m_size = (size_t) st.st_size;
+    }
+
+    MappedFile::~MappedFile() {
+        munmap( m_addr , m_size );
+    }
+
+    #endif
+
+} // namespace SigmaTransform
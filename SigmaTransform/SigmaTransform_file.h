@@ -0,0 +1,78 @@
+#ifndef SIGMATRANSFORM_FILE_H
+#define SIGMATRANSFORM_FILE_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace SigmaTransform {
+
+    /** Class for a read-only file, mapped into memory (mmap on POSIX systems, a file mapping on Windows).
+    *
+    *   The mapping starts at a page boundary and lives as long as the object; it stays valid, even if the
+    *   file is replaced or removed in the meantime.
+    */
+    class MappedFile {
+        public:
+            /** Constructor, mapping the whole file.
+             *
+             *  @param  filename    the name of the file
+             *
+             *  @throws             std::runtime_error, if the file cannot be opened, is empty or cannot be mapped
+             */
+            explicit MappedFile( std::string const& filename );
+
+            ~MappedFile();
+
+            // the mapped bytes and their number
+            const char*     data()  const { return (const char*) m_addr; }
+            size_t          size()  const { return m_size; }
+
+        private:
+            MappedFile( MappedFile const& );
+            MappedFile& operator=( MappedFile const& );
+
+            void*           m_addr;
+            size_t          m_size;
+            #ifdef _WIN32
+            void*           m_file;
+            void*           m_map;
+            #endif
+    };
+
+    /** Class for a 64 bit fingerprint (FNV-1a) of a sequence of values, e.g. of the parameters of a transform.
+    */
+    class Fingerprint {
+        public:
+            Fingerprint() : m_hash( 14695981039346656037ULL ) {}
+
+            /** Adds the bytes of a buffer to the fingerprint.
+             *
+             *  @param  data        pointer to the bytes
+             *  @param  len         the number of bytes
+             *
+             *  @return             reference to the fingerprint
+             */
+            Fingerprint& add( const void* data , size_t const& len ) {
+                const unsigned char* p = (const unsigned char*) data;
+                for( size_t i = 0 ; i < len ; ++i )
+                    m_hash = ( m_hash ^ p[i] ) * 1099511628211ULL;
+                return *this;
+            }
+
+            // adds a string, including its length, or the bytes of a trivially copyable value
+            Fingerprint& add( std::string const& str ) { add( (uint64_t) str.size() ); return add( str.data() , str.size() ); }
+            Fingerprint& add( const char* str )        { return add( std::string( str ) ); }
+            template<class V>
+            Fingerprint& add( V const& value )         { return add( &value , sizeof(V) ); }
+
+            // the fingerprint
+            uint64_t value() const { return m_hash; }
+
+        private:
+            uint64_t    m_hash;
+    };
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_FILE_H
@@ -0,0 +1,122 @@
+#ifndef SIGMATRANSFORM_FUNCTORS_H
+#define SIGMATRANSFORM_FUNCTORS_H
+
+#include <math.h>
+#include <complex>
+
+#include "SigmaTransform_util.h"
+
+namespace SigmaTransform {
+
+    /** Function objects for the built-in diffeomorphisms, windows and actions.
+    *
+    *   Unlike function pointers or std::function, their calls are resolved at compile time and may be
+    *   inlined into the loops over the samples, when used as template parameters of SigmaTransformT.
+    *   The free functions "id", "logabs", "polar", etc. compute the same values. Each functor also
+    *   has a batch form, operating on a pointArray, see the namespace "batch".
+    */
+    namespace functors {
+
+        // identical diffeomorphism, see "id"
+        template<size_t N>
+        struct Identity {
+            point<N> operator()( const point<N> &x ) const { return x; }
+            void     operator()( pointArray<N> &x ) const { }
+        };
+
+        // logarithm of the modulus, see "logabs"
+        template<size_t N>
+        struct LogAbs {
+            point<N> operator()( const point<N> &x ) const { return logabs<N>( x ); }
+            void     operator()( pointArray<N> &x ) const { batch::logabs<N>( x ); }
+        };
+
+        // "positive" logarithm, see "logpos"
+        template<size_t N>
+        struct LogPos {
+            point<N> operator()( const point<N> &x ) const { return logpos<N>( x ); }
+            void     operator()( pointArray<N> &x ) const { batch::logpos<N>( x ); }
+        };
+
+        // constant-Q diffeomorphism Q * log2( |x| / f_0 ), as used by CQTransform1D
+        struct ConstantQ {
+            double Q, f_0;
+            ConstantQ( double const& q = 8 , double const& f0 = 1 ) : Q( q ), f_0( f0 ) {}
+            point<1> operator()( const point<1> &x ) const { return Q * log2( std::abs( x[0] / f_0 ) + 1E-16 ); }
+            void     operator()( pointArray<1> &x ) const {
+                double* p = x[0];
+                for( size_t i = 0 ; i < x.size() ; ++i ) p[i] = Q * log2( std::abs( p[i] / f_0 ) + 1E-16 );
+            }
+        };
+
+        // polar diffeomorphism, see "polar"
+        struct Polar {
+            point<2> operator()( const point<2> &p ) const {
+                return point<2>( std::array<double,2>{ log2( p.sq().sum()+1E-16 )/2.0, atan( p[1] / p[0] ) } );
+            }
+            void operator()( pointArray<2> &p ) const {
+                double *x = p[0], *y = p[1];
+                for( size_t i = 0 ; i < p.size() ; ++i ) {
+                    double r = log2( x[i]*x[i] + y[i]*y[i] + 1E-16 )/2.0, phi = atan( y[i] / x[i] );
+                    x[i] = r;
+                    y[i] = phi;
+                }
+            }
+        };
+
+        // shear diffeomorphism, see "shear"
+        struct Shear {
+            point<2> operator()( const point<2> &p ) const {
+                return point<2>( std::array<double,2>{ log2( std::abs( p[0] ) + 1E-16 ), p[1] / p[0] } );
+            }
+            void operator()( pointArray<2> &p ) const {
+                double *x = p[0], *y = p[1];
+                for( size_t i = 0 ; i < p.size() ; ++i ) {
+                    y[i] = y[i] / x[i];
+                    x[i] = log2( std::abs( x[i] ) + 1E-16 );
+                }
+            }
+        };
+
+        // subtraction, see "minus"
+        template<size_t N>
+        struct Minus {
+            point<N> operator()( const point<N> &l , const point<N> &r ) const { return l - r; }
+            void     operator()( pointArray<N> &l , const point<N> &r ) const { batch::minus<N>( l , r ); }
+        };
+
+        // addition, see "plus"
+        template<size_t N>
+        struct Plus {
+            point<N> operator()( const point<N> &l , const point<N> &r ) const { return l + r; }
+            void     operator()( pointArray<N> &l , const point<N> &r ) const { batch::plus<N>( l , r ); }
+        };
+
+        // parabolic shift, see "parabolicAction"
+        struct ParabolicAction {
+            point<2> operator()( const point<2> &l , const point<2> &r ) const {
+                return point<2>( std::array<double,2>{ l[0] - r[0] , exp( -r[0] / 2.0 * log(2) ) * ( l[1] - r[1] ) } );
+            }
+            void operator()( pointArray<2> &l , const point<2> &r ) const {
+                double *x = l[0], *y = l[1], scale = exp( -r[0] / 2.0 * log(2) );
+                for( size_t i = 0 ; i < l.size() ; ++i ) {
+                    x[i] = x[i] - r[0];
+                    y[i] = scale * ( y[i] - r[1] );
+                }
+            }
+        };
+
+        // Gaussian window of a specific standard deviation, see "gauss_stddev"
+        template<size_t N>
+        struct GaussStddev {
+            point<N> stddev;
+            GaussStddev( point<N> const& sd = point<N>(1.0) ) : stddev( sd ) {}
+            std::complex<double> operator()( const point<N> &x ) const { return gauss_stddev<N>( x , stddev ); }
+            void                 operator()( const pointArray<N> &x , std::complex<double>* out ) const { batch::gauss_stddev<N>( x , stddev , out ); }
+        };
+
+    } // namespace functors
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_FUNCTORS_H
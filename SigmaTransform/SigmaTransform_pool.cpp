@@ -0,0 +1,264 @@
+
+#include <map>
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "SigmaTransform_pool.h"
+
+namespace SigmaTransform {
+
+    ThreadPool::ThreadPool( int const& numThreads , bool const& pinThreads )
+        : m_fn(NULL), m_ctx(NULL), m_numTasks(0), m_next(0), m_active(0), m_generation(0), m_stop(false) {
+        for( int k = 1 ; k < numThreads ; ++k )
+            m_workers.emplace_back( &ThreadPool::worker , this , k , pinThreads );
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk( m_mtx );
+            m_stop = true;
+        }
+        m_cvWork.notify_all();
+        for( auto& t : m_workers )
+            t.join();
+    }
+
+    // process-wide pools, one per size
+    std::shared_ptr<ThreadPool> ThreadPool::shared( int const& numThreads ) {
+        static std::mutex                                   mtx;
+        static std::map<int,std::weak_ptr<ThreadPool>>     pools;
+        std::lock_guard<std::mutex> lk( mtx );
+        std::shared_ptr<ThreadPool> pool = pools[numThreads].lock();
+        if( !pool ) {
+            pool = std::make_shared<ThreadPool>( numThreads );
+            pools[numThreads] = pool;
+        }
+        return pool;
+    }
+
+    // the pool, whose tasks the calling thread is working on, NULL if none
+    static thread_local const ThreadPool* t_working = NULL;
+
+    // runs a loop on the pool, or in the calling thread if the pool is busy; a loop started from within a task
+    // of the pool is run serially, without trying "m_dispatch", which the thread may hold itself
+    void ThreadPool::run( int const& numTasks , void(*fn)(void*,int) , void* ctx ) {
+        std::unique_lock<std::mutex> dispatch;
+        if( t_working != this )
+            dispatch = std::unique_lock<std::mutex>( m_dispatch , std::try_to_lock );
+        if( !dispatch.owns_lock() || m_workers.empty() || numTasks < 2 ) {
+            for( int k = 0 ; k < numTasks ; ++k )
+                fn( ctx , k );
+            return;
+        }
+        // publish the loop, after late workers checked out of the previous one
+        {
+            std::unique_lock<std::mutex> lk( m_mtx );
+            m_cvDone.wait( lk , [this](){ return m_active == 0; } );
+            m_fn        = fn;
+            m_ctx       = ctx;
+            m_numTasks  = numTasks;
+            m_error     = NULL;
+            m_next.store( 0 );
+            ++m_generation;
+        }
+        m_cvWork.notify_all();
+        // take part in the work
+        work( fn , ctx , numTasks );
+        // wait for the workers, which are still busy with this loop
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lk( m_mtx );
+            m_cvDone.wait( lk , [this](){ return m_active == 0; } );
+            std::swap( error , m_error );
+        }
+        if( error )
+            std::rethrow_exception( error );
+    }
+
+    // works on the tasks of the current loop, until there are none left
+    void ThreadPool::work( void(*fn)(void*,int) , void* ctx , int const& numTasks ) {
+        // mark the thread as working on this pool, for the loops started by the tasks
+        const ThreadPool* outer = t_working;
+        t_working = this;
+        for( int k = m_next++ ; k < numTasks ; k = m_next++ ) {
+            try {
+                fn( ctx , k );
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lk( m_mtx );
+                if( !m_error )
+                    m_error = std::current_exception();
+            }
+        }
+        t_working = outer;
+    }
+
+    // the worker threads' loop
+    void ThreadPool::worker( int const& id , bool const& pin ) {
+        #ifdef __linux__
+        if( pin ) {
+            cpu_set_t cpus;
+            CPU_ZERO( &cpus );
+            // hardware_concurrency may be unknown, i.e. zero
+            CPU_SET( id % std::max( 1u , std::thread::hardware_concurrency() ) , &cpus );
+            if( pthread_setaffinity_np( pthread_self() , sizeof(cpu_set_t) , &cpus ) != 0 )
+                std::cerr << "could not pin worker thread " << id << "\n";
+        }
+        #endif
+        unsigned long seen = 0;
+        for(;;) {
+            void(*fn)(void*,int);
+            void* ctx;
+            int   numTasks;
+            // wait for a new loop
+            {
+                std::unique_lock<std::mutex> lk( m_mtx );
+                m_cvWork.wait( lk , [&](){ return m_stop || m_generation != seen; } );
+                if( m_stop )
+                    return;
+                seen     = m_generation;
+                fn       = m_fn;
+                ctx      = m_ctx;
+                numTasks = m_numTasks;
+                ++m_active;
+            }
+            work( fn , ctx , numTasks );
+            // check out of the loop
+            {
+                std::lock_guard<std::mutex> lk( m_mtx );
+                if( --m_active == 0 )
+                    m_cvDone.notify_all();
+            }
+        }
+    }
+
+    JobQueue::JobQueue( int const& numThreads ) : m_stop(false) {
+        for( int k = 0 ; k < std::max( numThreads , 1 ) ; ++k )
+            m_workers.emplace_back( &JobQueue::worker , this );
+    }
+
+    JobQueue::~JobQueue() {
+        {
+            std::lock_guard<std::mutex> lk( m_mtx );
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for( auto& t : m_workers )
+            t.join();
+    }
+
+    // process-wide queues, one per number of workers
+    std::shared_ptr<JobQueue> JobQueue::shared( int const& numThreads ) {
+        static std::mutex                                   mtx;
+        static std::map<int,std::weak_ptr<JobQueue>>       queues;
+        std::lock_guard<std::mutex> lk( mtx );
+        std::shared_ptr<JobQueue> queue = queues[numThreads].lock();
+        if( !queue ) {
+            queue = std::make_shared<JobQueue>( numThreads );
+            queues[numThreads] = queue;
+        }
+        return queue;
+    }
+
+    void JobQueue::post( std::function<void()> job ) {
+        {
+            std::lock_guard<std::mutex> lk( m_mtx );
+            m_jobs.push_back( std::move( job ) );
+        }
+        m_cv.notify_one();
+    }
+
+    // the worker threads' loop: runs the jobs, until the queue is stopped and empty
+    void JobQueue::worker() {
+        for(;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lk( m_mtx );
+                m_cv.wait( lk , [this](){ return m_stop || !m_jobs.empty(); } );
+                if( m_jobs.empty() )
+                    return;
+                job = std::move( m_jobs.front() );
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    // the jobs of a strand, of which at most one is posted to its queue at a time
+    struct JobStrand::State {
+        std::mutex                                                                  mtx;
+        std::condition_variable                                                     cvDone;
+        std::deque<std::pair<std::shared_ptr<JobQueue>,std::function<void()>>>     jobs;
+        std::exception_ptr                                                          error;
+        int                                                                         pending = 0;
+    };
+
+    JobStrand::JobStrand() : m_state( std::make_shared<State>() ) { }
+
+    std::future<void> JobStrand::submit( std::shared_ptr<JobQueue> const& queue , std::function<void()> job ) {
+        // the task stores the job's exception in the future, and the first one of the strand in its state
+        std::shared_ptr<State> state = m_state;
+        std::shared_ptr<std::packaged_task<void()>> task = std::make_shared<std::packaged_task<void()>>( [state,job]() {
+            try {
+                job();
+            } catch( ... ) {
+                std::lock_guard<std::mutex> lk( state->mtx );
+                if( !state->error )
+                    state->error = std::current_exception();
+                throw;
+            }
+        } );
+        std::future<void> done = task->get_future();
+        bool idle;
+        {
+            std::lock_guard<std::mutex> lk( m_state->mtx );
+            m_state->jobs.emplace_back( queue , [task](){ (*task)(); } );
+            idle = ( m_state->pending++ == 0 );
+        }
+        // start the strand, if no job of it is queued or running
+        if( idle )
+            dispatch( m_state );
+        return done;
+    }
+
+    // posts the next job of the strand, which posts its successor when done
+    void JobStrand::dispatch( std::shared_ptr<State> const& state ) {
+        std::pair<std::shared_ptr<JobQueue>,std::function<void()>> next;
+        {
+            std::lock_guard<std::mutex> lk( state->mtx );
+            next = std::move( state->jobs.front() );
+            state->jobs.pop_front();
+        }
+        std::function<void()> job = std::move( next.second );
+        next.first->post( [state,job](){
+            job();
+            bool more;
+            {
+                std::lock_guard<std::mutex> lk( state->mtx );
+                more = ( --state->pending > 0 );
+                if( !more )
+                    state->cvDone.notify_all();
+            }
+            if( more )
+                dispatch( state );
+        } );
+    }
+
+    std::exception_ptr JobStrand::wait() {
+        std::unique_lock<std::mutex> lk( m_state->mtx );
+        m_state->cvDone.wait( lk , [this](){ return m_state->pending == 0; } );
+        std::exception_ptr error;
+        std::swap( error , m_state->error );
+        return error;
+    }
+
+    int JobStrand::pending() {
+        std::lock_guard<std::mutex> lk( m_state->mtx );
+        return m_state->pending;
+    }
+
+} // namespace SigmaTransform
@@ -0,0 +1,198 @@
+#ifndef SIGMATRANSFORM_POOL_H
+#define SIGMATRANSFORM_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <type_traits>
+#include <functional>
+#include <future>
+
+namespace SigmaTransform {
+
+    /** Class for a pool of long-lived worker threads.
+    *
+    *   The pool runs parallel loops: the tasks 0,...,numTasks-1 of a loop are distributed
+    *   among the workers and the calling thread, which takes part in the work and returns,
+    *   when all tasks are done. A pool of size "n" thus owns "n-1" worker threads.
+    *
+    *   A pool may be shared between several SigmaTransform-objects. If it is already busy
+    *   with a loop of another thread, or if a loop is started from within a task, the tasks
+    *   of the new loop are executed by the calling thread.
+    */
+    class ThreadPool {
+        public:
+            /** Constructor.
+             *
+             *  @param  numThreads  the number of threads working on a loop, including the calling thread
+             *  @param  pinThreads  if true, the worker threads are pinned to the cores 1,...,numThreads-1
+             *                      (only supported on Linux, ignored elsewhere)
+             */
+            explicit ThreadPool( int const& numThreads = std::thread::hardware_concurrency() , bool const& pinThreads = false );
+
+            ~ThreadPool();
+
+            /** Returns a process-wide pool of the given size, shared by all callers asking for the same size.
+             *  The pool is destroyed when the last holder releases it.
+             *
+             *  @param  numThreads  the number of threads working on a loop, including the calling thread
+             *
+             *  @return             shared pointer to the pool
+             */
+            static std::shared_ptr<ThreadPool> shared( int const& numThreads );
+
+            /** Returns the number of threads working on a loop, including the calling thread.
+             *
+             *  @return             number of threads
+             */
+            int size() const { return (int) m_workers.size() + 1; }
+
+            /** Runs "task( k )" for k = 0,...,numTasks-1 in parallel and blocks, until all tasks are done.
+             *  Exceptions thrown by a task are rethrown in the calling thread.
+             *
+             *  @param  numTasks    number of tasks
+             *  @param  task        a callable, taking the task's index
+             *
+             *  @return             void
+             */
+            template<class F>
+            void parallelFor( int const& numTasks , F&& task ) {
+                run( numTasks , &trampoline<typename std::remove_reference<F>::type> , (void*) &task );
+            }
+
+        private:
+            ThreadPool( ThreadPool const& ) = delete;
+            ThreadPool& operator=( ThreadPool const& ) = delete;
+
+            // calls the type-erased task, without allocating a std::function
+            template<class F>
+            static void trampoline( void* task , int k ) { (*static_cast<F*>( task ))( k ); }
+
+            void run( int const& numTasks , void(*fn)(void*,int) , void* ctx );
+            void work( void(*fn)(void*,int) , void* ctx , int const& numTasks );
+            void worker( int const& id , bool const& pin );
+
+            std::vector<std::thread>    m_workers;
+
+            // serializes the loops run on the pool
+            std::mutex                  m_dispatch;
+
+            // the current loop
+            std::mutex                  m_mtx;
+            std::condition_variable     m_cvWork;
+            std::condition_variable     m_cvDone;
+            void                        (*m_fn)(void*,int);
+            void*                       m_ctx;
+            int                         m_numTasks;
+            std::atomic<int>            m_next;
+            int                         m_active;
+            unsigned long               m_generation;
+            std::exception_ptr          m_error;
+            bool                        m_stop;
+    };
+
+    /** Class for a queue of jobs, run by long-lived worker threads.
+    *
+    *   Unlike the loops of a ThreadPool, a job is posted and the posting thread returns immediately;
+    *   the workers take the jobs from the queue in the order they were posted. A queue may be shared
+    *   between several SigmaTransform-objects, whose jobs then run concurrently. On destruction, the
+    *   jobs still queued are run, before the workers are joined.
+    */
+    class JobQueue {
+        public:
+            /** Constructor.
+             *
+             *  @param  numThreads  the number of worker threads, at least one
+             */
+            explicit JobQueue( int const& numThreads = std::thread::hardware_concurrency() );
+
+            ~JobQueue();
+
+            /** Returns a process-wide queue with the given number of workers, shared by all callers asking
+             *  for the same number. The queue is destroyed when the last holder releases it.
+             *
+             *  @param  numThreads  the number of worker threads
+             *
+             *  @return             shared pointer to the queue
+             */
+            static std::shared_ptr<JobQueue> shared( int const& numThreads = std::thread::hardware_concurrency() );
+
+            /** Returns the number of worker threads.
+             *
+             *  @return             number of threads
+             */
+            int size() const { return (int) m_workers.size(); }
+
+            /** Posts a job to the queue and returns immediately. The job must not throw.
+             *
+             *  @param  job         the job
+             *
+             *  @return             void
+             */
+            void post( std::function<void()> job );
+
+        private:
+            JobQueue( JobQueue const& ) = delete;
+            JobQueue& operator=( JobQueue const& ) = delete;
+
+            void worker();
+
+            std::vector<std::thread>            m_workers;
+            std::mutex                          m_mtx;
+            std::condition_variable             m_cv;
+            std::deque<std::function<void()>>   m_jobs;
+            bool                                m_stop;
+    };
+
+    /** Class for a strand of jobs on a JobQueue: the jobs of a strand run one at a time, in the order
+    *   they were submitted, while the jobs of different strands run concurrently on the workers.
+    *
+    *   The state of the strand is shared with its queued jobs, hence a strand may be destroyed while
+    *   jobs are pending; the jobs themselves must keep alive, what they refer to (see "wait").
+    */
+    class JobStrand {
+        public:
+            JobStrand();
+
+            /** Submits a job, which runs after all jobs submitted before to this strand are done.
+             *
+             *  @param  queue       the queue running the job
+             *  @param  job         the job
+             *
+             *  @return             a future, which becomes ready when the job is done, and which rethrows
+             *                      the exceptions thrown by the job
+             */
+            std::future<void> submit( std::shared_ptr<JobQueue> const& queue , std::function<void()> job );
+
+            /** Blocks, until all jobs submitted to the strand are done. Must not be called from within a job
+             *  of the strand.
+             *
+             *  @return             the first exception thrown by a job since the previous call (which is also
+             *                      reported by the job's future), NULL if none
+             */
+            std::exception_ptr wait();
+
+            /** Returns the number of jobs submitted and not done yet.
+             *
+             *  @return             number of pending jobs
+             */
+            int pending();
+
+        private:
+            JobStrand( JobStrand const& ) = delete;
+            JobStrand& operator=( JobStrand const& ) = delete;
+
+            struct State;
+            static void dispatch( std::shared_ptr<State> const& state );
+
+            std::shared_ptr<State>      m_state;
+    };
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_POOL_H
@@ -0,0 +1,447 @@
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include "SigmaTransform_simd.h"
+
+// hand-vectorized kernels on x86 with GCC, which compiles them for each instruction set by "#pragma GCC target"
+#if defined(__GNUC__) && !defined(__clang__) && ( defined(__x86_64__) || defined(__i386__) )
+    #define SIGMATRANSFORM_SIMD_X86
+    #if __GNUC__ >= 5
+        #define SIGMATRANSFORM_SIMD_AVX512
+    #endif
+    #include <immintrin.h>
+#endif
+
+namespace SigmaTransform {
+
+    // reference implementation and the remainder of the vectorized loops
+    namespace scalar {
+
+        // a * b, computed as by the vectorized kernels
+        template<class T>
+        inline std::complex<T> cmul( std::complex<T> const& a , std::complex<T> const& b ) {
+            return std::complex<T>( a.real()*b.real() - a.imag()*b.imag() , a.imag()*b.real() + a.real()*b.imag() );
+        }
+
+        // conj( w ) * x, computed as by the vectorized kernels
+        template<class T>
+        inline std::complex<T> conjMul( std::complex<T> const& w , std::complex<T> const& x ) {
+            return std::complex<T>( x.real()*w.real() + x.imag()*w.imag() , x.imag()*w.real() - x.real()*w.imag() );
+        }
+
+        template<class T>
+        void conjMulScale( std::complex<T>* out , const std::complex<T>* w , const std::complex<T>* x , T s , size_t n ) {
+            for( size_t i = 0 ; i < n ; ++i ) {
+                std::complex<T> p = conjMul( w[i] , x[i] );
+                out[i] = std::complex<T>( p.real() * s , p.imag() * s );
+            }
+        }
+
+        template<class T>
+        void mul( std::complex<T>* x , const std::complex<T>* m , size_t n ) {
+            for( size_t i = 0 ; i < n ; ++i )
+                x[i] = cmul( x[i] , m[i] );
+        }
+
+        template<class T>
+        void mulAcc( std::complex<T>* acc , const std::complex<T>* a , const std::complex<T>* b , T s , size_t n ) {
+            for( size_t i = 0 ; i < n ; ++i ) {
+                std::complex<T> p = cmul( a[i] , b[i] );
+                acc[i] = std::complex<T>( acc[i].real() + p.real() * s , acc[i].imag() + p.imag() * s );
+            }
+        }
+
+        template<class T>
+        void realMulScale( std::complex<T>* out , const T* w , const std::complex<T>* x , T s , size_t n ) {
+            for( size_t i = 0 ; i < n ; ++i )
+                out[i] = std::complex<T>( x[i].real() * w[i] * s , x[i].imag() * w[i] * s );
+        }
+
+        template<class T>
+        void realMulAcc( std::complex<T>* acc , const std::complex<T>* a , const T* w , T s , size_t n ) {
+            for( size_t i = 0 ; i < n ; ++i )
+                acc[i] = std::complex<T>( acc[i].real() + a[i].real() * w[i] * s , acc[i].imag() + a[i].imag() * w[i] * s );
+        }
+
+    } // namespace scalar
+
+    #ifdef SIGMATRANSFORM_SIMD_X86
+
+    /*  Each instruction set holds one complex double or two complex floats per 128 bits. The products are
+        formed from the duplicated real and imaginary parts of one factor and the other factor with swapped
+        parts; flipping the sign of every other lane then gives the same sums and differences as "scalar::cmul"
+        and "scalar::conjMul". Real factors are loaded duplicated, once for the real and once for the imaginary part.
+    */
+
+    #pragma GCC push_options
+    #pragma GCC target("sse2")
+    namespace sse2 {
+
+        inline __m128d  load( const std::complex<double>* p )           { return _mm_loadu_pd( (const double*) p ); }
+        inline __m128   load( const std::complex<float>* p )            { return _mm_loadu_ps( (const float*) p ); }
+        inline void     store( std::complex<double>* p , __m128d v )    { _mm_storeu_pd( (double*) p , v ); }
+        inline void     store( std::complex<float>* p , __m128 v )      { _mm_storeu_ps( (float*) p , v ); }
+        inline __m128d  set1( double s )                                { return _mm_set1_pd( s ); }
+        inline __m128   set1( float s )                                 { return _mm_set1_ps( s ); }
+        inline __m128d  add( __m128d a , __m128d b )                    { return _mm_add_pd( a , b ); }
+        inline __m128   add( __m128 a , __m128 b )                      { return _mm_add_ps( a , b ); }
+        inline __m128d  mul( __m128d a , __m128d b )                    { return _mm_mul_pd( a , b ); }
+        inline __m128   mul( __m128 a , __m128 b )                      { return _mm_mul_ps( a , b ); }
+
+        inline __m128d cmul( __m128d a , __m128d b ) {
+            __m128d t1 = _mm_mul_pd( a , _mm_shuffle_pd( b , b , 0 ) );
+            __m128d t2 = _mm_mul_pd( _mm_shuffle_pd( a , a , 1 ) , _mm_shuffle_pd( b , b , 3 ) );
+            return _mm_add_pd( t1 , _mm_xor_pd( t2 , _mm_set_pd( 0.0 , -0.0 ) ) );
+        }
+        inline __m128 cmul( __m128 a , __m128 b ) {
+            __m128 t1 = _mm_mul_ps( a , _mm_shuffle_ps( b , b , _MM_SHUFFLE(2,2,0,0) ) );
+            __m128 t2 = _mm_mul_ps( _mm_shuffle_ps( a , a , _MM_SHUFFLE(2,3,0,1) ) , _mm_shuffle_ps( b , b , _MM_SHUFFLE(3,3,1,1) ) );
+            return _mm_add_ps( t1 , _mm_xor_ps( t2 , _mm_set_ps( 0.0f , -0.0f , 0.0f , -0.0f ) ) );
+        }
+        inline __m128d conjMul( __m128d w , __m128d x ) {
+            __m128d t1 = _mm_mul_pd( x , _mm_shuffle_pd( w , w , 0 ) );
+            __m128d t2 = _mm_mul_pd( _mm_shuffle_pd( x , x , 1 ) , _mm_shuffle_pd( w , w , 3 ) );
+            return _mm_add_pd( t1 , _mm_xor_pd( t2 , _mm_set_pd( -0.0 , 0.0 ) ) );
+        }
+        inline __m128 conjMul( __m128 w , __m128 x ) {
+            __m128 t1 = _mm_mul_ps( x , _mm_shuffle_ps( w , w , _MM_SHUFFLE(2,2,0,0) ) );
+            __m128 t2 = _mm_mul_ps( _mm_shuffle_ps( x , x , _MM_SHUFFLE(2,3,0,1) ) , _mm_shuffle_ps( w , w , _MM_SHUFFLE(3,3,1,1) ) );
+            return _mm_add_ps( t1 , _mm_xor_ps( t2 , _mm_set_ps( -0.0f , 0.0f , -0.0f , 0.0f ) ) );
+        }
+
+        // the real factors of the complex numbers in a register, each duplicated
+        inline __m128d  loadDup( const double* p )  { return _mm_set1_pd( *p ); }
+        inline __m128   loadDup( const float* p )   { __m128 v = _mm_castpd_ps( _mm_load_sd( (const double*) p ) ); return _mm_unpacklo_ps( v , v ); }
+
+        template<class T>
+        void conjMulScale( std::complex<T>* out , const std::complex<T>* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 16 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( conjMul( load( w + i ) , load( x + i ) ) , vs ) );
+            scalar::conjMulScale( out + i , w + i , x + i , s , n - i );
+        }
+
+        template<class T>
+        void mul( std::complex<T>* x , const std::complex<T>* m , size_t n ) {
+            const size_t width = 16 / sizeof( std::complex<T> );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( x + i , cmul( load( x + i ) , load( m + i ) ) );
+            scalar::mul( x + i , m + i , n - i );
+        }
+
+        template<class T>
+        void mulAcc( std::complex<T>* acc , const std::complex<T>* a , const std::complex<T>* b , T s , size_t n ) {
+            const size_t width = 16 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( cmul( load( a + i ) , load( b + i ) ) , vs ) ) );
+            scalar::mulAcc( acc + i , a + i , b + i , s , n - i );
+        }
+
+        template<class T>
+        void realMulScale( std::complex<T>* out , const T* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 16 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( mul( load( x + i ) , loadDup( w + i ) ) , vs ) );
+            scalar::realMulScale( out + i , w + i , x + i , s , n - i );
+        }
+
+        template<class T>
+        void realMulAcc( std::complex<T>* acc , const std::complex<T>* a , const T* w , T s , size_t n ) {
+            const size_t width = 16 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( mul( load( a + i ) , loadDup( w + i ) ) , vs ) ) );
+            scalar::realMulAcc( acc + i , a + i , w + i , s , n - i );
+        }
+
+    } // namespace sse2
+    #pragma GCC pop_options
+
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+    namespace avx2 {
+
+        inline __m256d  load( const std::complex<double>* p )           { return _mm256_loadu_pd( (const double*) p ); }
+        inline __m256   load( const std::complex<float>* p )            { return _mm256_loadu_ps( (const float*) p ); }
+        inline void     store( std::complex<double>* p , __m256d v )    { _mm256_storeu_pd( (double*) p , v ); }
+        inline void     store( std::complex<float>* p , __m256 v )      { _mm256_storeu_ps( (float*) p , v ); }
+        inline __m256d  set1( double s )                                { return _mm256_set1_pd( s ); }
+        inline __m256   set1( float s )                                 { return _mm256_set1_ps( s ); }
+        inline __m256d  add( __m256d a , __m256d b )                    { return _mm256_add_pd( a , b ); }
+        inline __m256   add( __m256 a , __m256 b )                      { return _mm256_add_ps( a , b ); }
+        inline __m256d  mul( __m256d a , __m256d b )                    { return _mm256_mul_pd( a , b ); }
+        inline __m256   mul( __m256 a , __m256 b )                      { return _mm256_mul_ps( a , b ); }
+
+        inline __m256d cmul( __m256d a , __m256d b ) {
+            __m256d t1 = _mm256_mul_pd( a , _mm256_movedup_pd( b ) );
+            __m256d t2 = _mm256_mul_pd( _mm256_permute_pd( a , 0x5 ) , _mm256_permute_pd( b , 0xF ) );
+            return _mm256_addsub_pd( t1 , t2 );
+        }
+        inline __m256 cmul( __m256 a , __m256 b ) {
+            __m256 t1 = _mm256_mul_ps( a , _mm256_moveldup_ps( b ) );
+            __m256 t2 = _mm256_mul_ps( _mm256_permute_ps( a , _MM_SHUFFLE(2,3,0,1) ) , _mm256_movehdup_ps( b ) );
+            return _mm256_addsub_ps( t1 , t2 );
+        }
+        inline __m256d conjMul( __m256d w , __m256d x ) {
+            __m256d t1 = _mm256_mul_pd( x , _mm256_movedup_pd( w ) );
+            __m256d t2 = _mm256_mul_pd( _mm256_permute_pd( x , 0x5 ) , _mm256_permute_pd( w , 0xF ) );
+            return _mm256_add_pd( t1 , _mm256_xor_pd( t2 , _mm256_set_pd( -0.0 , 0.0 , -0.0 , 0.0 ) ) );
+        }
+        inline __m256 conjMul( __m256 w , __m256 x ) {
+            __m256 t1 = _mm256_mul_ps( x , _mm256_moveldup_ps( w ) );
+            __m256 t2 = _mm256_mul_ps( _mm256_permute_ps( x , _MM_SHUFFLE(2,3,0,1) ) , _mm256_movehdup_ps( w ) );
+            return _mm256_add_ps( t1 , _mm256_xor_ps( t2 , _mm256_set_ps( -0.0f , 0.0f , -0.0f , 0.0f , -0.0f , 0.0f , -0.0f , 0.0f ) ) );
+        }
+
+        // the real factors of the complex numbers in a register, each duplicated
+        inline __m256d loadDup( const double* p ) {
+            return _mm256_permute4x64_pd( _mm256_castpd128_pd256( _mm_loadu_pd( p ) ) , 0x50 );
+        }
+        inline __m256 loadDup( const float* p ) {
+            __m128 v = _mm_loadu_ps( p );
+            return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_unpacklo_ps( v , v ) ) , _mm_unpackhi_ps( v , v ) , 1 );
+        }
+
+        template<class T>
+        void conjMulScale( std::complex<T>* out , const std::complex<T>* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 32 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( conjMul( load( w + i ) , load( x + i ) ) , vs ) );
+            scalar::conjMulScale( out + i , w + i , x + i , s , n - i );
+        }
+
+        template<class T>
+        void mul( std::complex<T>* x , const std::complex<T>* m , size_t n ) {
+            const size_t width = 32 / sizeof( std::complex<T> );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( x + i , cmul( load( x + i ) , load( m + i ) ) );
+            scalar::mul( x + i , m + i , n - i );
+        }
+
+        template<class T>
+        void mulAcc( std::complex<T>* acc , const std::complex<T>* a , const std::complex<T>* b , T s , size_t n ) {
+            const size_t width = 32 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( cmul( load( a + i ) , load( b + i ) ) , vs ) ) );
+            scalar::mulAcc( acc + i , a + i , b + i , s , n - i );
+        }
+
+        template<class T>
+        void realMulScale( std::complex<T>* out , const T* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 32 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( mul( load( x + i ) , loadDup( w + i ) ) , vs ) );
+            scalar::realMulScale( out + i , w + i , x + i , s , n - i );
+        }
+
+        template<class T>
+        void realMulAcc( std::complex<T>* acc , const std::complex<T>* a , const T* w , T s , size_t n ) {
+            const size_t width = 32 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( mul( load( a + i ) , loadDup( w + i ) ) , vs ) ) );
+            scalar::realMulAcc( acc + i , a + i , w + i , s , n - i );
+        }
+
+    } // namespace avx2
+    #pragma GCC pop_options
+
+    #ifdef SIGMATRANSFORM_SIMD_AVX512
+    #pragma GCC push_options
+    #pragma GCC target("avx512f")
+    // the rounding-mode intrinsics of some GCC versions trigger false warnings
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    namespace avx512 {
+
+        inline __m512d  load( const std::complex<double>* p )           { return _mm512_loadu_pd( (const double*) p ); }
+        inline __m512   load( const std::complex<float>* p )            { return _mm512_loadu_ps( (const float*) p ); }
+        inline void     store( std::complex<double>* p , __m512d v )    { _mm512_storeu_pd( (double*) p , v ); }
+        inline void     store( std::complex<float>* p , __m512 v )      { _mm512_storeu_ps( (float*) p , v ); }
+        inline __m512d  set1( double s )                                { return _mm512_set1_pd( s ); }
+        inline __m512   set1( float s )                                 { return _mm512_set1_ps( s ); }
+        // the forms with rounding mode, which are not fused into multiply-adds, as AVX-512F implies FMA
+        inline __m512d  add( __m512d a , __m512d b )                    { return _mm512_add_round_pd( a , b , _MM_FROUND_CUR_DIRECTION ); }
+        inline __m512   add( __m512 a , __m512 b )                      { return _mm512_add_round_ps( a , b , _MM_FROUND_CUR_DIRECTION ); }
+        inline __m512d  mul( __m512d a , __m512d b )                    { return _mm512_mul_round_pd( a , b , _MM_FROUND_CUR_DIRECTION ); }
+        inline __m512   mul( __m512 a , __m512 b )                      { return _mm512_mul_round_ps( a , b , _MM_FROUND_CUR_DIRECTION ); }
+
+        // the first "n" complex numbers, for the remainder of the loops
+        inline __m512d  load( const std::complex<double>* p , size_t n )        { return _mm512_maskz_loadu_pd( (__mmask8) ( ( 1u << 2*n ) - 1 ) , (const double*) p ); }
+        inline __m512   load( const std::complex<float>* p , size_t n )         { return _mm512_maskz_loadu_ps( (__mmask16) ( ( 1u << 2*n ) - 1 ) , (const float*) p ); }
+        inline void     store( std::complex<double>* p , __m512d v , size_t n ) { _mm512_mask_storeu_pd( (double*) p , (__mmask8) ( ( 1u << 2*n ) - 1 ) , v ); }
+        inline void     store( std::complex<float>* p , __m512 v , size_t n )   { _mm512_mask_storeu_ps( (float*) p , (__mmask16) ( ( 1u << 2*n ) - 1 ) , v ); }
+
+        // flips the sign of the real (even) or imaginary (odd) parts; AVX-512F has no floating point xor
+        const long long SIGN = (long long) 0x8000000000000000ULL;
+        inline __m512d negEven( __m512d v ) { return _mm512_castsi512_pd( _mm512_xor_si512( _mm512_castpd_si512( v ) , _mm512_set_epi64( 0 , SIGN , 0 , SIGN , 0 , SIGN , 0 , SIGN ) ) ); }
+        inline __m512d negOdd( __m512d v )  { return _mm512_castsi512_pd( _mm512_xor_si512( _mm512_castpd_si512( v ) , _mm512_set_epi64( SIGN , 0 , SIGN , 0 , SIGN , 0 , SIGN , 0 ) ) ); }
+        inline __m512  negEven( __m512 v )  { return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( v ) , _mm512_set1_epi64( 0x80000000LL ) ) ); }
+        inline __m512  negOdd( __m512 v )   { return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( v ) , _mm512_set1_epi64( SIGN ) ) ); }
+
+        inline __m512d cmul( __m512d a , __m512d b ) {
+            __m512d t1 = mul( a , _mm512_shuffle_pd( b , b , 0x00 ) );
+            __m512d t2 = mul( _mm512_shuffle_pd( a , a , 0x55 ) , _mm512_shuffle_pd( b , b , 0xFF ) );
+            return add( t1 , negEven( t2 ) );
+        }
+        inline __m512 cmul( __m512 a , __m512 b ) {
+            __m512 t1 = mul( a , _mm512_shuffle_ps( b , b , _MM_SHUFFLE(2,2,0,0) ) );
+            __m512 t2 = mul( _mm512_shuffle_ps( a , a , _MM_SHUFFLE(2,3,0,1) ) , _mm512_shuffle_ps( b , b , _MM_SHUFFLE(3,3,1,1) ) );
+            return add( t1 , negEven( t2 ) );
+        }
+        inline __m512d conjMul( __m512d w , __m512d x ) {
+            __m512d t1 = mul( x , _mm512_shuffle_pd( w , w , 0x00 ) );
+            __m512d t2 = mul( _mm512_shuffle_pd( x , x , 0x55 ) , _mm512_shuffle_pd( w , w , 0xFF ) );
+            return add( t1 , negOdd( t2 ) );
+        }
+        inline __m512 conjMul( __m512 w , __m512 x ) {
+            __m512 t1 = mul( x , _mm512_shuffle_ps( w , w , _MM_SHUFFLE(2,2,0,0) ) );
+            __m512 t2 = mul( _mm512_shuffle_ps( x , x , _MM_SHUFFLE(2,3,0,1) ) , _mm512_shuffle_ps( w , w , _MM_SHUFFLE(3,3,1,1) ) );
+            return add( t1 , negOdd( t2 ) );
+        }
+
+        // the real factors of the first "n" complex numbers in a register, each duplicated
+        inline __m512d loadDup( const double* p , size_t n = 4 ) {
+            __m512d v = _mm512_maskz_loadu_pd( (__mmask8) ( ( 1u << n ) - 1 ) , p );
+            return _mm512_permutexvar_pd( _mm512_set_epi64( 3 , 3 , 2 , 2 , 1 , 1 , 0 , 0 ) , v );
+        }
+        inline __m512 loadDup( const float* p , size_t n = 8 ) {
+            __m512 v = _mm512_maskz_loadu_ps( (__mmask16) ( ( 1u << n ) - 1 ) , p );
+            return _mm512_permutexvar_ps( _mm512_set_epi32( 7 , 7 , 6 , 6 , 5 , 5 , 4 , 4 , 3 , 3 , 2 , 2 , 1 , 1 , 0 , 0 ) , v );
+        }
+
+        template<class T>
+        void conjMulScale( std::complex<T>* out , const std::complex<T>* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 64 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( conjMul( load( w + i ) , load( x + i ) ) , vs ) );
+            if( i < n )
+                store( out + i , mul( conjMul( load( w + i , n - i ) , load( x + i , n - i ) ) , vs ) , n - i );
+        }
+
+        template<class T>
+        void mul( std::complex<T>* x , const std::complex<T>* m , size_t n ) {
+            const size_t width = 64 / sizeof( std::complex<T> );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( x + i , cmul( load( x + i ) , load( m + i ) ) );
+            if( i < n )
+                store( x + i , cmul( load( x + i , n - i ) , load( m + i , n - i ) ) , n - i );
+        }
+
+        template<class T>
+        void mulAcc( std::complex<T>* acc , const std::complex<T>* a , const std::complex<T>* b , T s , size_t n ) {
+            const size_t width = 64 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( cmul( load( a + i ) , load( b + i ) ) , vs ) ) );
+            if( i < n )
+                store( acc + i , add( load( acc + i , n - i ) , mul( cmul( load( a + i , n - i ) , load( b + i , n - i ) ) , vs ) ) , n - i );
+        }
+
+        template<class T>
+        void realMulScale( std::complex<T>* out , const T* w , const std::complex<T>* x , T s , size_t n ) {
+            const size_t width = 64 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( out + i , mul( mul( load( x + i ) , loadDup( w + i ) ) , vs ) );
+            if( i < n )
+                store( out + i , mul( mul( load( x + i , n - i ) , loadDup( w + i , n - i ) ) , vs ) , n - i );
+        }
+
+        template<class T>
+        void realMulAcc( std::complex<T>* acc , const std::complex<T>* a , const T* w , T s , size_t n ) {
+            const size_t width = 64 / sizeof( std::complex<T> );
+            auto vs = set1( s );
+            size_t i = 0;
+            for( ; i + width <= n ; i += width )
+                store( acc + i , add( load( acc + i ) , mul( mul( load( a + i ) , loadDup( w + i ) ) , vs ) ) );
+            if( i < n )
+                store( acc + i , add( load( acc + i , n - i ) , mul( mul( load( a + i , n - i ) , loadDup( w + i , n - i ) ) , vs ) ) , n - i );
+        }
+
+    } // namespace avx512
+    #pragma GCC diagnostic pop
+    #pragma GCC pop_options
+    #endif
+
+    #endif
+
+    SimdLevel detectSimdLevel() {
+        SimdLevel level = SimdLevel::Scalar;
+        #ifdef SIGMATRANSFORM_SIMD_X86
+        __builtin_cpu_init();
+        if( __builtin_cpu_supports( "sse2" ) )
+            level = SimdLevel::SSE2;
+        if( __builtin_cpu_supports( "avx2" ) )
+            level = SimdLevel::AVX2;
+        #ifdef SIGMATRANSFORM_SIMD_AVX512
+        if( __builtin_cpu_supports( "avx512f" ) )
+            level = SimdLevel::AVX512;
+        #endif
+        #endif
+        return level;
+    }
+
+    const char* simdLevelName( SimdLevel const& level ) {
+        static const char* names[] = { "scalar" , "SSE2" , "AVX2" , "AVX-512" };
+        return names[(int) level];
+    }
+
+    template<class T>
+    ComplexKernels<T> const& ComplexKernels<T>::get( SimdLevel const& level ) {
+        // indexed by the level
+        static const ComplexKernels<T> table[] = {
+            { scalar::conjMulScale<T> , scalar::mul<T> , scalar::mulAcc<T> , scalar::realMulScale<T> , scalar::realMulAcc<T> , SimdLevel::Scalar }
+            #ifdef SIGMATRANSFORM_SIMD_X86
+           ,{ sse2::conjMulScale<T>   , sse2::mul<T>   , sse2::mulAcc<T>   , sse2::realMulScale<T>   , sse2::realMulAcc<T>   , SimdLevel::SSE2 }
+           ,{ avx2::conjMulScale<T>   , avx2::mul<T>   , avx2::mulAcc<T>   , avx2::realMulScale<T>   , avx2::realMulAcc<T>   , SimdLevel::AVX2 }
+            #ifdef SIGMATRANSFORM_SIMD_AVX512
+           ,{ avx512::conjMulScale<T> , avx512::mul<T> , avx512::mulAcc<T> , avx512::realMulScale<T> , avx512::realMulAcc<T> , SimdLevel::AVX512 }
+            #endif
+            #endif
+        };
+        static const SimdLevel best = detectSimdLevel();
+        return table[ std::min( (int) level , (int) best ) ];
+    }
+
+    template<class T>
+    ComplexKernels<T> const& ComplexKernels<T>::get() {
+        // the environment variable SIGMATRANSFORM_SIMD may restrict the level, e.g. to "scalar" or "SSE2"
+        static ComplexKernels<T> const& kernels = []() -> ComplexKernels<T> const& {
+            SimdLevel   level = SimdLevel::AVX512;
+            const char* env   = getenv( "SIGMATRANSFORM_SIMD" );
+            for( int l = 0 ; env && l <= (int) SimdLevel::AVX512 ; ++l )
+                if( !strcmp( env , simdLevelName( (SimdLevel) l ) ) )
+                    level = (SimdLevel) l;
+            return get( level );
+        }();
+        return kernels;
+    }
+
+    // precompiled instantiations
+    template class ComplexKernels<double>;
+    template class ComplexKernels<float>;
+
+} // namespace SigmaTransform
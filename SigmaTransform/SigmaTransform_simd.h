@@ -0,0 +1,76 @@
+#ifndef SIGMATRANSFORM_SIMD_H
+#define SIGMATRANSFORM_SIMD_H
+
+#include <complex>
+#include <cstddef>
+
+namespace SigmaTransform {
+
+    // instruction sets, for which the complex kernels are compiled, in increasing order
+    enum class SimdLevel { Scalar = 0 , SSE2 = 1 , AVX2 = 2 , AVX512 = 3 };
+
+    /** Returns the best instruction set supported by the CPU (determined by CPUID) and by the compiler.
+     *
+     *  @return             the instruction set
+     */
+    SimdLevel detectSimdLevel();
+
+    /** Returns the name of an instruction set, e.g. "AVX2".
+     *
+     *  @param  level       the instruction set
+     *
+     *  @return             the name
+     */
+    const char* simdLevelName( SimdLevel const& level );
+
+    /** Class template for the complex kernels of the coefficient loops, hand-vectorized for SSE2, AVX2 and AVX-512.
+    *
+    *   The kernels operate on arrays of interleaved complex numbers of type std::complex<T>, with T being double or
+    *   float, and the "real" kernels on arrays of real factors of type T, e.g. of real windows. Every level computes
+    *   each sample by the same operations in the same order and without fused multiply-adds, hence the results do not
+    *   depend on the instruction set selected at runtime (unless the library itself is compiled with FMA enabled, e.g.
+    *   by -march=native). The environment variable SIGMATRANSFORM_SIMD, set to the name of a level (see
+    *   "simdLevelName"), restricts the selection, e.g. "scalar" or "SSE2".
+    */
+    template<class T>
+    class ComplexKernels {
+        public:
+            using cmpx = std::complex<T>;
+
+            // out[i] = conj( w[i] ) * x[i] * s,   i = 0,...,n-1
+            void (*conjMulScale)( cmpx* out , const cmpx* w , const cmpx* x , T s , size_t n );
+
+            // x[i] *= m[i],                        i = 0,...,n-1
+            void (*mul)( cmpx* x , const cmpx* m , size_t n );
+
+            // acc[i] += a[i] * b[i] * s,           i = 0,...,n-1
+            void (*mulAcc)( cmpx* acc , const cmpx* a , const cmpx* b , T s , size_t n );
+
+            // out[i] = w[i] * x[i] * s, with real w,  i = 0,...,n-1
+            void (*realMulScale)( cmpx* out , const T* w , const cmpx* x , T s , size_t n );
+
+            // acc[i] += a[i] * w[i] * s, with real w, i = 0,...,n-1
+            void (*realMulAcc)( cmpx* acc , const cmpx* a , const T* w , T s , size_t n );
+
+            // the instruction set of the kernels
+            SimdLevel level;
+
+            /** Returns the kernels for the best instruction set of this machine, see "detectSimdLevel".
+             *
+             *  @return             reference to the kernels
+             */
+            static ComplexKernels const& get();
+
+            /** Returns the kernels for a specific instruction set, e.g. for benchmarking. If the instruction set
+             *  is not supported, the kernels of the best supported one below it are returned.
+             *
+             *  @param  level       the instruction set
+             *
+             *  @return             reference to the kernels
+             */
+            static ComplexKernels const& get( SimdLevel const& level );
+    };
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_SIMD_H
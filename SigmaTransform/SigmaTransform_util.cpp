@@ -95,10 +95,20 @@ namespace SigmaTransform {
         return domain;
     }
 
-    // Starts a recursive loop and applies "toDo" for each point between (0,...,0) and "(max_1,...,max_n)"
+    // Starts a loop and applies "toDo" for each point between (0,...,0) and "(max_1,...,max_n)", the first index running fastest
     void StartRecursiveLoop( const std::vector<int>& max , std::function<void(const std::vector<int>&)> toDo ) {
-        std::vector<int> index; index.resize( max.size() , 0 );
-        recursiveLoop( index , max , max.size()-1 , toDo );
+        if( max.empty() || *std::min_element( max.begin() , max.end() ) <= 0 )
+            return;
+        std::vector<int> index( max.size() , 0 );
+        for( ;; ) {
+            toDo( index );
+            // increment like an odometer
+            size_t k = 0;
+            while( k < max.size() && ++index[k] == max[k] )
+                index[k++] = 0;
+            if( k == max.size() )
+                return;
+        }
     }
 
     // Applies a recursive loop, which replaces an arbitrary number of nested loops
@@ -11,6 +11,13 @@
 #include <algorithm>
 #include <mutex>
 #include <functional>
+#include <iterator>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 #define DEBUG
 
@@ -23,6 +30,8 @@
 
 #include <fftw3.h>
 
+#include "SigmaTransform_pool.h"
+
 namespace SigmaTransform {
 
 	const double PI     	= 3.141592654;
@@ -149,6 +158,82 @@ namespace SigmaTransform {
 
     };
 
+    /** Allocator for std::vector, aligning the storage to "Align" bytes (a cache line, by default), such
+    *   that vectorized loops over the elements start on an aligned address.
+    */
+    template<class T, size_t Align = 64>
+    struct AlignedAllocator {
+        typedef T value_type;
+
+        template<class U> struct rebind { typedef AlignedAllocator<U,Align> other; };
+
+        AlignedAllocator() {}
+        template<class U> AlignedAllocator( AlignedAllocator<U,Align> const& ) {}
+
+        T* allocate( size_t const& n ) {
+            if( !n ) return nullptr;
+            void* p = nullptr;
+#ifdef _WIN32
+            p = _aligned_malloc( n * sizeof(T) , Align );
+#else
+            if( posix_memalign( &p , Align , n * sizeof(T) ) ) p = nullptr;
+#endif
+            if( !p ) throw std::bad_alloc();
+            return static_cast<T*>( p );
+        }
+
+        void deallocate( T* p , size_t const& ) {
+#ifdef _WIN32
+            _aligned_free( p );
+#else
+            free( p );
+#endif
+        }
+
+        template<class U> bool operator==( AlignedAllocator<U,Align> const& ) const { return true; }
+        template<class U> bool operator!=( AlignedAllocator<U,Align> const& ) const { return false; }
+    };
+
+    /** Class template for an array of N-dimensional points, stored as one contiguous array per axis
+    *   ("structure of arrays"), such that loops over the points may be vectorized.
+    *
+    *   It is taken by the batch forms of the diffeomorphisms, actions and windows, which evaluate
+    *   many points in a single call, and holds the warped Fourier domain of a transform. The arrays
+    *   are aligned to cache lines.
+    */
+    template<size_t N>
+    class pointArray {
+            // private, internally handled data: the coordinates along each axis
+            std::array<std::vector<double,AlignedAllocator<double>>,N>  _data;
+
+        public:
+
+            // constructor
+            pointArray<N>( size_t const& n = 0 ) { resize( n ); }
+
+            // size
+            void    resize( size_t const& n )   { for( auto& d : _data ) d.resize( n ); }
+            size_t  size() const                { return _data[0].size(); }
+
+            // the coordinates along axis "k"
+            double*         operator[]( size_t const& k )       { return _data[k].data(); }
+            const double*   operator[]( size_t const& k ) const { return _data[k].data(); }
+
+            // conversion from and to single points
+            point<N> get( size_t const& i ) const { point<N> p; for( int k = 0 ; k < N ; ++k ) p[k] = _data[k][i]; return p; }
+            void     set( size_t const& i , point<N> const& p ) { for( int k = 0 ; k < N ; ++k ) _data[k][i] = p[k]; }
+
+            // copies "count" points from "p" into the array, resizing it, and vice versa
+            void load( const point<N>* p , size_t const& count ) { resize( count ); for( size_t i = 0 ; i < count ; ++i ) set( i , p[i] ); }
+            void store( point<N>* p ) const { for( size_t i = 0 ; i < size() ; ++i ) p[i] = get( i ); }
+
+            // copies "count" points of "src", starting at point "first", into the array, resizing it
+            void load( pointArray<N> const& src , size_t const& first , size_t const& count ) {
+                resize( count );
+                for( int k = 0 ; k < N ; ++k ) std::copy( src[k] + first , src[k] + first + count , _data[k].begin() );
+            }
+    };
+
     // shorthands for cleaner code
     using   cmpx        = std::complex<double>;
     using   cxVec       = std::vector<cmpx>;
@@ -157,6 +242,11 @@ namespace SigmaTransform {
     template<size_t N> using   winFunc  = std::function<cmpx(const point<N>&)>;
     template<size_t N> using   actFunc  = std::function<point<N>(const point<N>&,const point<N>&)>;
 
+    // batch forms, operating on many points at once: diffeomorphisms and actions in place, windows into a buffer
+    template<size_t N> using   diffBatchFunc = std::function<void(pointArray<N>&)>;
+    template<size_t N> using   winBatchFunc  = std::function<void(const pointArray<N>&,cmpx*)>;
+    template<size_t N> using   actBatchFunc  = std::function<void(pointArray<N>&,const point<N>&)>;
+
     /** Loads 1D-ASCII file.
      *
      *  @param  filename    the filename
@@ -198,7 +288,8 @@ namespace SigmaTransform {
      */
     std::vector<double> FourierAxis( const double &fs , const unsigned &len );
 
-    /** Starts a recursive loop and applies "toDo" for each point between (0,...,0) and "(max_1,...,max_n)"
+    /** Starts a loop and applies "toDo" for each point between (0,...,0) and "(max_1,...,max_n)", with the first
+    *  index running fastest. The loop is iterative, i.e. the index is incremented like an odometer.
     *
     *  @param  max         vector, containing the maximal iteration-indices
     *  @param  toDo        function handle, performing the nested operations, depending on the handed index
@@ -207,8 +298,8 @@ namespace SigmaTransform {
     */
     void StartRecursiveLoop( const std::vector<int>& max , std::function<void(const std::vector<int>&)> toDo );
 
-    /** Applies a recursive loop, which replaces an arbitrary number of nested loops; internally called by
-     *  "StartRecursiveLoop".
+    /** Applies a recursive loop, which replaces an arbitrary number of nested loops; kept for compatibility,
+     *  "StartRecursiveLoop" no longer uses it.
      *
      *  @param  index       vector, containing the current iteration-indices
      *  @param  max         vector, containing the maximal iteration-indices
@@ -220,64 +311,190 @@ namespace SigmaTransform {
     void recursiveLoop( std::vector<int> &index, const std::vector<int>& max , const int& curr_ind ,
                         std::function<void(const std::vector<int>&)> toDo );
 
-    /** Makes N-D-meshgrid from N 1D-vectors.
+    /** Class template for an implicit N-D meshgrid, which holds only its N axes and computes each point on
+    *   demand, such that large grids need not be materialized. The points are ordered as by "meshgridN",
+    *   i.e. with the first axis running fastest.
+    *
+    *   Its iterators step through the grid like an odometer; random access by a linear index costs
+    *   one division per axis.
+    */
+    template<size_t N>
+    class Grid {
+            // private, internally handled data: the axes and the number of points
+            std::array<std::vector<double>,N>   _axes;
+            size_t                              _size;
+
+        public:
+
+            // constructor
+            Grid( std::array<std::vector<double>,N> const& axes = std::array<std::vector<double>,N>() ) : _axes( axes ), _size( 1 ) {
+                for( auto const& a : _axes ) _size *= a.size();
+            }
+
+            // number of points, the axes
+            size_t                      size() const                    { return _size; }
+            std::vector<double> const&  axis( size_t const& k ) const   { return _axes[k]; }
+
+            // the point at linear index "i"
+            point<N> operator[]( size_t i ) const {
+                point<N> p;
+                for( int k = 0 ; k < N ; ++k ) {
+                    p[k] = _axes[k][i % _axes[k].size()];
+                    i   /= _axes[k].size();
+                }
+                return p;
+            }
+
+            /** Writes the points "first",...,"first+count-1" to "out".
+             *
+             *  @param  out         pointer to a buffer of "count" points
+             *  @param  first       linear index of the first point
+             *  @param  count       the number of points
+             *
+             *  @return             void
+             */
+            void fill( point<N>* out , size_t const& first , size_t const& count ) const {
+                const_iterator it( *this , first );
+                for( size_t i = 0 ; i < count ; ++i , ++it )
+                    out[i] = *it;
+            }
+
+            // forward iterator, incrementing the index along each axis like an odometer
+            class const_iterator {
+                    Grid const*         _grid;
+                    size_t              _pos;
+                    std::array<size_t,N> _idx;
+                    point<N>            _p;
+                public:
+                    typedef std::forward_iterator_tag   iterator_category;
+                    typedef point<N>                    value_type;
+                    typedef std::ptrdiff_t              difference_type;
+                    typedef point<N> const*             pointer;
+                    typedef point<N> const&             reference;
+
+                    const_iterator( Grid const& grid , size_t const& pos ) : _grid( &grid ), _pos( pos ) {
+                        size_t i = pos;
+                        for( int k = 0 ; k < N ; ++k ) {
+                            size_t n = grid._axes[k].size();
+                            _idx[k]  = n ? i % n : 0;
+                            _p[k]    = pos < grid._size ? grid._axes[k][_idx[k]] : 0.0;
+                            i        = n ? i / n : 0;
+                        }
+                    }
+
+                    reference       operator*()  const { return _p; }
+                    pointer         operator->() const { return &_p; }
+                    bool            operator==( const_iterator const& o ) const { return _pos == o._pos; }
+                    bool            operator!=( const_iterator const& o ) const { return _pos != o._pos; }
+
+                    const_iterator& operator++() {
+                        ++_pos;
+                        for( int k = 0 ; k < N ; ++k ) {
+                            std::vector<double> const& a = _grid->_axes[k];
+                            if( ++_idx[k] < a.size() ) {
+                                _p[k] = a[_idx[k]];
+                                break;
+                            }
+                            _idx[k] = 0;
+                            _p[k]   = a[0];
+                        }
+                        return *this;
+                    }
+            };
+
+            const_iterator begin() const { return const_iterator( *this , 0 ); }
+            const_iterator end()   const { return const_iterator( *this , _size ); }
+    };
+
+    /** Splits the outer (i.e. slowest) axis of a grid of "numel" points, with "outer" points along that axis,
+    *  into blocks and calls "f( first , count )" for the linear index range of each block, on the threads of
+    *  "pool", or on the calling thread, if "pool" is NULL.
+    *
+    *  @param  numel       the number of points of the grid
+    *  @param  outer       the number of points along the outer axis
+    *  @param  pool        the thread pool, may be NULL
+    *  @param  f           a callable
+    *
+    *  @return             void
+    */
+    template<class F>
+    void forEachOuterBlock( size_t const& numel , size_t const& outer , ThreadPool* pool , F const& f ) {
+        if( !numel )
+            return;
+        int    blocks = pool ? (int) std::min<size_t>( outer , 4 * pool->size() ) : 1;
+        size_t inner  = numel / outer;
+        if( blocks <= 1 ) {
+            f( 0 , numel );
+            return;
+        }
+        pool->parallelFor( blocks , [&]( int const& b ) {
+            size_t from = outer * b / blocks, to = outer * ( b + 1 ) / blocks;
+            f( from * inner , ( to - from ) * inner );
+        } );
+    }
+
+    /** Makes N-D-meshgrid from N 1D-vectors, with the first axis running fastest.
     *
     *  @param  dom         array containg N double-vectors
+    *  @param  pool        if given, the points are generated in parallel, split along the last axis; defaults to NULL
     *
     *  @return             N-D meshgrid
     */
     template<size_t N>
-    std::vector<point<N>> meshgridN( std::array<std::vector<double>,N> const& dom ) {
-        // make sizeVector for loop
-        std::vector<int> sizeVec(0);
-        int p = 1;
-        for( auto& d : dom ) {
-            p *= d.size();
-            sizeVec.push_back( d.size() );
-        }
-        // reserve space
-        std::vector<point<N>> out; out.reserve( p );
-        // use recursive loop - very slow, but replaces up to n nested loops
-        StartRecursiveLoop( sizeVec , [&](std::vector<int> const& index ) {
-            // get current point
-            point<N> p;
-            for( int k = 0 ; k < index.size() ; ++k )
-                p[k] = dom[k][index[k]];
-            // insert into vectors
-            out.emplace_back( p );
+    std::vector<point<N>> meshgridN( std::array<std::vector<double>,N> const& dom , ThreadPool* pool = NULL ) {
+        Grid<N> grid( dom );
+        std::vector<point<N>> out( grid.size() );
+        forEachOuterBlock( grid.size() , dom[N-1].size() , pool , [&]( size_t const& first , size_t const& count ) {
+            grid.fill( out.data() + first , first , count );
         } );
         // return output vector
-        return std::move( out );
+        return out;
+    }
+
+    /** Makes N-D-meshgrid from N 1D-vectors, as "meshgridN", but stored as one array per axis.
+    *
+    *  @param  dom         an array of N double-vectors
+    *  @param  pool        if given, the points are generated in parallel, split along the last axis; defaults to NULL
+    *
+    *  @return             N-D meshgrid
+    */
+    template<size_t N>
+    pointArray<N> meshgridArray( std::array<std::vector<double>,N> const& dom , ThreadPool* pool = NULL ) {
+        // number of points
+        size_t numel = 1;
+        for( auto& d : dom )
+            numel *= d.size();
+        pointArray<N> out( numel );
+        forEachOuterBlock( numel , dom[N-1].size() , pool , [&]( size_t const& first , size_t const& count ) {
+            // along axis k, each coordinate is repeated "stride" times; "first" is a multiple of each stride
+            size_t stride = 1;
+            for( int k = 0 ; k < N ; ++k ) {
+                double* x = out[k] + first;
+                size_t  j = ( first / stride ) % dom[k].size();
+                for( size_t i = 0 ; i < count ; i += stride , x += stride ) {
+                    std::fill( x , x + stride , dom[k][j] );
+                    if( ++j == dom[k].size() )
+                        j = 0;
+                }
+                stride *= dom[k].size();
+            }
+        } );
+        // return output array
+        return out;
     }
 
     /** Makes symmetric N-D-meshgrid from single 1D-vector.
     *
     *  @param  dom         a double-vectors
+    *  @param  pool        if given, the points are generated in parallel; defaults to NULL
     *
     *  @return             symmetric N-D meshgrid
     */
     template<size_t N>
-    std::vector<point<N>> meshgridN( std::vector<double> const& dom ) {
-        // make sizeVector for loop
-        std::vector<int> sizeVec(0);
-        int p = 1;
-        for(int k = 0 ; k < N;++k) {
-            p *= dom.size();
-            sizeVec.push_back( dom.size() );
-        }
-        // reserve space
-        std::vector<point<N>> out; out.reserve( p );
-        // use recursive loop - very slow, but replaces up to n nested loops
-        StartRecursiveLoop( sizeVec , [&](std::vector<int> const& index ) {
-            // get current point
-            point<N> p;
-            for( int k = 0 ; k < index.size() ; ++k )
-                p[k] = dom[index[k]];
-            // insert into vectors
-            out.emplace_back( p );
-        } );
-        // return output vector
-        return std::move( out );
+    std::vector<point<N>> meshgridN( std::vector<double> const& dom , ThreadPool* pool = NULL ) {
+        std::array<std::vector<double>,N> doms;
+        doms.fill( dom );
+        return meshgridN( doms , pool );
     }
 
     /** Saves N-dim complex vector to ASCII-file.
@@ -353,7 +570,7 @@ namespace SigmaTransform {
     *  @return             logarithm of x if positive, -inf else
     */
     template<size_t N>
-    point<N> logpos( const point<N> &x ) { return (x>0).apply( log2 ); }
+    point<N> logpos( const point<N> &x ) { return (x*(x>0)).apply( log2 ); }
 
     /** Identical diffeomorphism.
     *
@@ -387,6 +604,64 @@ namespace SigmaTransform {
         return exp( -PI * (x/stddev).sq().sum() ) * point<N>(pow2_1_4).prod();
     }
 
+    /** Batch forms of the functions above, taking an array of points and computing the same values as the
+    *   pointwise forms, e.g. batch::logabs<N>( points ). Diffeomorphisms and actions overwrite the points with
+    *   the result, windows write one value per point into "out". They live in a namespace of their own, such
+    *   that "logabs<N>" etc. still name a single function, e.g. when converted to a std::function-handle.
+    */
+    namespace batch {
+
+        template<size_t N>
+        void plus( pointArray<N> &l , const point<N> &r ) {
+            for( int k = 0 ; k < N ; ++k ) {
+                double* x = l[k];
+                for( size_t i = 0 ; i < l.size() ; ++i ) x[i] += r[k];
+            }
+        }
+
+        template<size_t N>
+        void minus( pointArray<N> &l , const point<N> &r ) {
+            for( int k = 0 ; k < N ; ++k ) {
+                double* x = l[k];
+                for( size_t i = 0 ; i < l.size() ; ++i ) x[i] -= r[k];
+            }
+        }
+
+        template<size_t N>
+        void logabs( pointArray<N> &p ) {
+            for( int k = 0 ; k < N ; ++k ) {
+                double* x = p[k];
+                for( size_t i = 0 ; i < p.size() ; ++i ) x[i] = log2( ( (x[i]>=0)?x[i]:-x[i] ) + 1E-16 );
+            }
+        }
+
+        template<size_t N>
+        void logpos( pointArray<N> &p ) {
+            for( int k = 0 ; k < N ; ++k ) {
+                double* x = p[k];
+                for( size_t i = 0 ; i < p.size() ; ++i ) x[i] = log2( x[i] * (double)( x[i] > 0 ) );
+            }
+        }
+
+        template<size_t N>
+        void id( pointArray<N> &p ) { }
+
+        template<size_t N>
+        void gauss_stddev( const pointArray<N> &p , const point<N> &stddev , cmpx* out ) {
+            double norm = point<N>(pow2_1_4).prod();
+            // the exponent of each point, summed up over the axes in their order, without a temporary buffer
+            for( size_t i = 0 ; i < p.size() ; ++i ) {
+                double e = 0.0;
+                for( int k = 0 ; k < N ; ++k ) { double y = p[k][i] / stddev[k]; e += y*y; }
+                out[i] = exp( -PI * e ) * norm;
+            }
+        }
+
+        template<size_t N>
+        void gauss( const pointArray<N> &p , cmpx* out ) { gauss_stddev( p , point<N>(1.0) , out ); }
+
+    } // namespace batch
+
 } // namespace SigmaTransform
 
 #endif //SIGMATRANSFORM_H
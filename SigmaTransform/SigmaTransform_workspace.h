@@ -0,0 +1,76 @@
+#ifndef SIGMATRANSFORM_WORKSPACE_H
+#define SIGMATRANSFORM_WORKSPACE_H
+
+#include <vector>
+#include <array>
+#include <complex>
+
+#include "SigmaTransform_util.h"
+#include "SigmaTransform_bank.h"
+
+namespace SigmaTransform {
+
+    // spatial domain of a lattice, kept for consecutive channels of the same size
+    template<size_t N>
+    struct LatticeDomain {
+        std::array<int,N>       size;
+        Grid<N>                 points;
+        LatticeDomain() { size.fill( -1 ); }
+    };
+
+    // buffers of a thread for evaluating windows: the dense window, a chunk of points and the window's values on them,
+    // and the rows of separable windows
+    template<size_t N, class T = double>
+    struct WindowScratch {
+        std::vector<std::complex<T>>                window;
+        pointArray<N>                               points;
+        std::vector<std::complex<double>>           values;
+        typename WindowBank<N,T>::RowBuffer         row;
+    };
+
+    /** Struct template for the scratch buffers of a SigmaTransform<N,T>, i.e. for everything "analyze", "synthesize",
+    *   "multiplier" and the masks need besides the window bank, the coefficients and the reconstruction.
+    *
+    *   The buffers are aligned to cache lines, which covers the alignment of fftw_malloc, such that FFTW plans
+    *   made for one of them apply to all. They grow on their first use and keep their memory afterwards, hence
+    *   repeated transforms of signals of the same shape do not allocate memory on the heap. A workspace may be
+    *   shared by several transforms, as long as they are not used at the same time.
+    */
+    template<size_t N, class T = double>
+    struct Workspace {
+        // complex samples of the given precision, in aligned memory
+        using cmpx          = std::complex<T>;
+        using alignedVec    = std::vector<cmpx,AlignedAllocator<cmpx>>;
+
+        // the spectrum of the signal, the spectra of the coefficients, and half spectra of real FFTs
+        alignedVec                      spectrum;
+        alignedVec                      coeffSpectrum;
+        alignedVec                      half;
+
+        // per thread: a spectrum of its own, the coefficients of a single channel, windows evaluated on the fly,
+        // and the spatial domain of the masks
+        std::vector<alignedVec>         partial;
+        std::vector<alignedVec>         coeff;
+        std::vector<WindowScratch<N,T>> scratch;
+        std::vector<LatticeDomain<N>>   domain;
+
+        /** Makes sure, there are buffers for at least "numThreads" threads.
+         *
+         *  @param  numThreads  the number of threads
+         *
+         *  @return             reference to the workspace
+         */
+        Workspace& reserveThreads( int const& numThreads ) {
+            if( (int) partial.size() < numThreads ) {
+                partial.resize( numThreads );
+                coeff.resize( numThreads );
+                scratch.resize( numThreads );
+                domain.resize( numThreads );
+            }
+            return *this;
+        }
+    };
+
+} // namespace SigmaTransform
+
+#endif //SIGMATRANSFORM_WORKSPACE_H